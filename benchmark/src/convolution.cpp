@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "counters.hpp"
+
+#include <mc/core/vector.hpp>
+#include <mc/fft.hpp>
+#include <mc/testing/test.hpp>
+
+#include <benchmark/benchmark.h>
+
+using namespace mc;
+
+namespace {
+
+// {signal, patch}, from short FIR filters to long impulse responses.
+auto convolutionSizes(benchmark::internal::Benchmark* b) -> void
+{
+    b->Args({4096, 16});
+    b->Args({4096, 256});
+    b->Args({65536, 64});
+    b->Args({65536, 2048});
+    b->Args({1 << 20, 512});
+}
+
+// Samples per second of signal, bytes count signal, patch & output.
+auto setConvolutionCounters(benchmark::State& state, size_t signal, size_t patch) -> void
+{
+    auto const bytes = (signal + patch + signal + patch - 1) * sizeof(float);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(signal));
+}
+
+auto BM_Convolute_Direct(benchmark::State& state) -> void
+{
+    auto const signalSize = static_cast<size_t>(state.range(0));
+    auto const patchSize  = static_cast<size_t>(state.range(1));
+    auto const signal     = generateRandomTestData(signalSize);
+    auto const patch      = generateRandomTestData(patchSize);
+    auto output           = Vector<float>(signalSize + patchSize - 1);
+
+    for (auto _ : state) {
+        convolute(Span<float const>{signal}, Span<float const>{patch}, output.data());
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    setConvolutionCounters(state, signalSize, patchSize);
+}
+
+BENCHMARK(BM_Convolute_Direct)->Apply(convolutionSizes)->Unit(benchmark::kMicrosecond);
+
+// {signal, patch}, one DWT level with the filter lengths of haar, db4, db10, coif5 & db31.
+auto waveletFilterSizes(benchmark::internal::Benchmark* b) -> void
+{
+    for (auto const taps : {2, 8, 20, 30, 62}) { b->Args({4096, taps}); }
+}
+
+// The plain loop convolute used before the vectorized kernels
+auto BM_Convolute_Scalar(benchmark::State& state) -> void
+{
+    auto const signalSize = static_cast<size_t>(state.range(0));
+    auto const patchSize  = static_cast<size_t>(state.range(1));
+    auto const signal     = generateRandomTestData(signalSize);
+    auto const patch      = generateRandomTestData(patchSize);
+    auto output           = Vector<float>(signalSize + patchSize - 1);
+
+    for (auto _ : state) {
+        convoluteScalar(Span<float const>{signal}, Span<float const>{patch}, output.data());
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    setConvolutionCounters(state, signalSize, patchSize);
+}
+
+BENCHMARK(BM_Convolute_Scalar)->Apply(waveletFilterSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Convolute_Direct)->Apply(waveletFilterSizes)->Unit(benchmark::kMicrosecond);
+
+auto BM_FFTConvolver(benchmark::State& state) -> void
+{
+    auto const signalSize = static_cast<size_t>(state.range(0));
+    auto const patchSize  = static_cast<size_t>(state.range(1));
+    auto const signal     = generateRandomTestData(signalSize);
+    auto const patch      = generateRandomTestData(patchSize);
+    auto output           = Vector<float>(signalSize + patchSize - 1);
+
+    auto convolver = FFTConvolver{signalSize, patchSize};
+    for (auto _ : state) {
+        convolute(convolver, signal, patch, output.data());
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    setConvolutionCounters(state, signalSize, patchSize);
+}
+
+BENCHMARK(BM_FFTConvolver)->Apply(convolutionSizes)->Unit(benchmark::kMicrosecond);
+
+auto BM_OverlapSaveConvolver(benchmark::State& state) -> void
+{
+    auto const signalSize = static_cast<size_t>(state.range(0));
+    auto const patchSize  = static_cast<size_t>(state.range(1));
+    auto signalData       = generateRandomTestData(signalSize);
+    auto patchData        = generateRandomTestData(patchSize);
+
+    auto signal    = FloatSignal{signalData.data(), signalSize};
+    auto patch     = FloatSignal{patchData.data(), patchSize};
+    auto output    = Vector<float>(signalSize + patchSize - 1);
+    auto convolver = OverlapSaveConvolver{signal, patch};
+    for (auto _ : state) {
+        convolver.convolute(output);
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+
+    setConvolutionCounters(state, signalSize, patchSize);
+}
+
+BENCHMARK(BM_OverlapSaveConvolver)->Apply(convolutionSizes)->Unit(benchmark::kMicrosecond);
+
+// {block, filter}, one block per iteration as in a real-time callback.
+auto BM_UniformPartitionedConvolver(benchmark::State& state) -> void
+{
+    auto const blockSize  = static_cast<size_t>(state.range(0));
+    auto const filterSize = static_cast<size_t>(state.range(1));
+    auto const filter     = generateRandomTestData(filterSize);
+    auto block            = generateRandomTestData(blockSize);
+
+    auto convolver = UniformPartitionedConvolver{filter, blockSize};
+    for (auto _ : state) {
+        convolver.process(block, block);
+        benchmark::DoNotOptimize(block.data());
+        benchmark::ClobberMemory();
+    }
+
+    setConvolutionCounters(state, blockSize, filterSize);
+}
+
+BENCHMARK(BM_UniformPartitionedConvolver)
+    ->ArgsProduct({{64, 256, 512}, {256, 4096, 65536}})
+    ->Unit(benchmark::kMicrosecond);
+
+auto BM_NonUniformPartitionedConvolver(benchmark::State& state) -> void
+{
+    auto const blockSize  = static_cast<size_t>(state.range(0));
+    auto const filterSize = static_cast<size_t>(state.range(1));
+    auto const filter     = generateRandomTestData(filterSize);
+    auto block            = generateRandomTestData(blockSize);
+
+    auto convolver = NonUniformPartitionedConvolver{filter, blockSize};
+    for (auto _ : state) {
+        convolver.process(block, block);
+        benchmark::DoNotOptimize(block.data());
+        benchmark::ClobberMemory();
+    }
+
+    setConvolutionCounters(state, blockSize, filterSize);
+}
+
+BENCHMARK(BM_NonUniformPartitionedConvolver)
+    ->ArgsProduct({{64, 256, 512}, {256, 4096, 65536}})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+}  // namespace
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/cmath.hpp>
+#include <mc/core/cstddef.hpp>
+#include <mc/core/cstdint.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace mc {
+
+/// Flops of a size n complex transform by the usual 5 N log2(N) convention. Used for
+/// every size & backend, so the numbers compare throughput, not actual operation counts.
+[[nodiscard]] inline auto complexFFTFlops(size_t n) -> double
+{
+    auto const size = static_cast<double>(n);
+    return 5.0 * size * std::log2(size);
+}
+
+/// Real transforms are counted as half a complex one.
+[[nodiscard]] inline auto realFFTFlops(size_t n) -> double
+{
+    return complexFFTFlops(n) / 2.0;
+}
+
+/// Reports GFLOPS & bytes/s. flops & bytes are per iteration, bytes counts everything
+/// read & written by the transform. Call after the benchmark loop.
+inline auto setThroughputCounters(benchmark::State& state, double flops, size_t bytes)
+    -> void
+{
+    auto const gflops = benchmark::Counter{
+        flops * 1e-9,
+        benchmark::Counter::kIsIterationInvariantRate,
+    };
+    state.counters["GFLOPS"] = gflops;
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+
+}  // namespace mc
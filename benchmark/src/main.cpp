@@ -0,0 +1,24 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/string.hpp>
+
+#include <pffft.h>
+
+#include <benchmark/benchmark.h>
+
+// Same as BENCHMARK_MAIN, but records the selected backends in the context section of
+// the report, so archived JSON results can be told apart.
+auto main(int argc, char** argv) -> int
+{
+    benchmark::AddCustomContext("mc_fft_simd_level", mc::toString(mc::simdLevel()));
+    benchmark::AddCustomContext("mc_fft_threads", std::to_string(mc::fftThreads()));
+    benchmark::AddCustomContext("pffft_simd_size", std::to_string(pffft_simd_size()));
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
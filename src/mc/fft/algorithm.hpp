@@ -8,3 +8,4 @@
 #include <mc/fft/algorithm/rms_error.hpp>
 #include <mc/fft/algorithm/spectral_convolution.hpp>
 #include <mc/fft/algorithm/spectral_correlation.hpp>
+#include <mc/fft/algorithm/spectral_multiply.hpp>
@@ -2,6 +2,8 @@
 
 #include "spectral_convolution.hpp"
 
+#include <mc/fft/algorithm/spectral_multiply.hpp>
+
 #include <mc/core/cassert.hpp>
 
 namespace mc {
@@ -12,7 +14,33 @@ auto spectralConvolution(
 ) -> void
 {
     MC_ASSERT((a.size() == result.size()) && (b.size() == result.size()));
-    for (size_t i = 0; i < a.size(); ++i) { result[i] = a[i] * b[i]; }
+    spectralMultiply(a, b, result, false);
+}
+
+auto spectralConvolutionPacked(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> result
+) -> void
+{
+    MC_ASSERT((a.size() == result.size()) && (b.size() == result.size()));
+    if (result.empty()) { return; }
+
+    result[0] = {a[0].real() * b[0].real(), a[0].imag() * b[0].imag()};
+    spectralMultiply(a.subspan(1), b.subspan(1), result.subspan(1), false);
+}
+
+auto spectralConvolutionPackedAccumulate(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> result
+) -> void
+{
+    MC_ASSERT((a.size() == result.size()) && (b.size() == result.size()));
+    if (result.empty()) { return; }
+
+    result[0] += Complex<float>{a[0].real() * b[0].real(), a[0].imag() * b[0].imag()};
+    spectralMultiplyAccumulate(a.subspan(1), b.subspan(1), result.subspan(1));
 }
 
 }  // namespace mc
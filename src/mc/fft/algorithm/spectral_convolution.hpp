@@ -18,4 +18,20 @@ auto spectralConvolution(
     Span<Complex<float>> result
 ) -> void;
 
+/// Same as spectralConvolution, but on packed real spectra (see rfftPacked). Slot 0 holds
+/// the real valued DC & Nyquist bins, which are multiplied component-wise.
+auto spectralConvolutionPacked(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> result
+) -> void;
+
+/// Adds the product of two packed real spectra to result, see spectralConvolutionPacked.
+/// Used to sum the partial products of partitioned convolutions.
+auto spectralConvolutionPackedAccumulate(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> result
+) -> void;
+
 }  // namespace mc
@@ -2,6 +2,8 @@
 
 #include "spectral_correlation.hpp"
 
+#include <mc/fft/algorithm/spectral_multiply.hpp>
+
 #include <mc/core/cassert.hpp>
 
 namespace mc {
@@ -13,7 +15,20 @@ auto spectralCorrelation(
 ) -> void
 {
     MC_ASSERT((a.size() == result.size()) && (b.size() == result.size()));
-    for (size_t i{0}; i < a.size(); ++i) { result[i] = a[i] * std::conj(b[i]); }
+    spectralMultiply(a, b, result, true);
+}
+
+auto spectralCorrelationPacked(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> result
+) -> void
+{
+    MC_ASSERT((a.size() == result.size()) && (b.size() == result.size()));
+    if (result.empty()) { return; }
+
+    result[0] = {a[0].real() * b[0].real(), a[0].imag() * b[0].imag()};
+    spectralMultiply(a.subspan(1), b.subspan(1), result.subspan(1), true);
 }
 
 }  // namespace mc
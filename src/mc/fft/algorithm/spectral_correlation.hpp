@@ -15,4 +15,11 @@ auto spectralCorrelation(
     Span<Complex<float>> result
 ) -> void;
 
+/// Same as spectralCorrelation, but on packed real spectra (see rfftPacked).
+auto spectralCorrelationPacked(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> result
+) -> void;
+
 }  // namespace mc
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "spectral_multiply.hpp"
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/transform/simd.hpp>
+
+#include <mc/core/cassert.hpp>
+
+namespace mc {
+
+namespace {
+
+// Spelled out instead of std::complex::operator*, which handles inf/nan through a
+// library call and keeps the loop from being vectorized.
+template<bool Conjugate, bool Accumulate>
+MC_FFT_ALWAYS_INLINE
+auto multiply(float const* a, float const* b, float* out, size_t n) -> void
+{
+    for (auto i = size_t{0}; i < n; ++i) {
+        auto const ar = a[2 * i];
+        auto const ai = a[2 * i + 1];
+        auto const br = b[2 * i];
+        auto const bi = Conjugate ? -b[2 * i + 1] : b[2 * i + 1];
+        if constexpr (Accumulate) {
+            out[2 * i] += ar * br - ai * bi;
+            out[2 * i + 1] += ar * bi + ai * br;
+        } else {
+            out[2 * i]     = ar * br - ai * bi;
+            out[2 * i + 1] = ar * bi + ai * br;
+        }
+    }
+}
+
+#if MC_FFT_HAS_TARGET_ATTRIBUTE
+template<bool Conjugate, bool Accumulate>
+MC_FFT_TARGET("avx2,fma")
+auto multiplyAVX2(float const* a, float const* b, float* out, size_t n) -> void
+{
+    multiply<Conjugate, Accumulate>(a, b, out, n);
+}
+#endif
+
+}  // namespace
+
+auto spectralMultiply(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> out,
+    bool conjugate
+) -> void
+{
+    MC_ASSERT((a.size() == out.size()) && (b.size() == out.size()));
+
+    auto const* x = reinterpret_cast<float const*>(a.data());  // NOLINT
+    auto const* y = reinterpret_cast<float const*>(b.data());  // NOLINT
+    auto* z       = reinterpret_cast<float*>(out.data());      // NOLINT
+    auto const n  = out.size();
+
+#if MC_FFT_HAS_TARGET_ATTRIBUTE
+    if (simdLevel() == SimdLevel::avx2) {
+        if (conjugate) { return multiplyAVX2<true, false>(x, y, z, n); }
+        return multiplyAVX2<false, false>(x, y, z, n);
+    }
+#endif
+
+    if (conjugate) { return multiply<true, false>(x, y, z, n); }
+    return multiply<false, false>(x, y, z, n);
+}
+
+auto spectralMultiplyAccumulate(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> out
+) -> void
+{
+    MC_ASSERT((a.size() == out.size()) && (b.size() == out.size()));
+
+    auto const* x = reinterpret_cast<float const*>(a.data());  // NOLINT
+    auto const* y = reinterpret_cast<float const*>(b.data());  // NOLINT
+    auto* z       = reinterpret_cast<float*>(out.data());      // NOLINT
+    auto const n  = out.size();
+
+#if MC_FFT_HAS_TARGET_ATTRIBUTE
+    if (simdLevel() == SimdLevel::avx2) {
+        return multiplyAVX2<false, true>(x, y, z, n);
+    }
+#endif
+
+    multiply<false, true>(x, y, z, n);
+}
+
+}  // namespace mc
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/complex.hpp>
+#include <mc/core/span.hpp>
+
+namespace mc {
+
+/// Element-wise out = a * b, or out = a * conj(b) if conjugate is set. Runs the widest
+/// kernel allowed by simdLevel(). out may alias a or b.
+auto spectralMultiply(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> out,
+    bool conjugate
+) -> void;
+
+/// Element-wise out += a * b, with the same dispatch as spectralMultiply. out must not
+/// alias a or b.
+auto spectralMultiplyAccumulate(
+    Span<Complex<float> const> a,
+    Span<Complex<float> const> b,
+    Span<Complex<float>> out
+) -> void;
+
+}  // namespace mc
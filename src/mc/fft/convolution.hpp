@@ -3,6 +3,10 @@
 #pragma once
 
 #include <mc/fft/convolution/convolute.hpp>
+#include <mc/fft/convolution/convolution_cost_model.hpp>
 #include <mc/fft/convolution/convolution_method.hpp>
+#include <mc/fft/convolution/direct_convolution.hpp>
 #include <mc/fft/convolution/fft_convolver.hpp>
+#include <mc/fft/convolution/non_uniform_partitioned_convolver.hpp>
 #include <mc/fft/convolution/overlap_save_convolver.hpp>
+#include <mc/fft/convolution/uniform_partitioned_convolver.hpp>
@@ -2,9 +2,12 @@
 
 #pragma once
 
+#include <mc/fft/convolution/direct_convolution.hpp>
+
 #include <mc/core/algorithm.hpp>
 #include <mc/core/cstddef.hpp>
 #include <mc/core/span.hpp>
+#include <mc/core/type_traits.hpp>
 
 namespace mc {
 template<typename Convolver>
@@ -18,8 +21,10 @@ auto convolute(
     return c.convolute(s, p, out);
 }
 
+/// Full linear convolution as a plain loop, used for all types without a vectorized
+/// kernel.
 template<typename T>
-auto convolute(Span<T const> signal, Span<T const> patch, T* output) noexcept -> void
+auto convoluteScalar(Span<T const> signal, Span<T const> patch, T* output) noexcept -> void
 {
     size_t n      = signal.size();
     size_t l      = patch.size();
@@ -35,7 +40,7 @@ auto convolute(Span<T const> signal, Span<T const> patch, T* output) noexcept ->
             output[k] = 0.0;
             i++;
             auto const t1   = l + i;
-            auto const tmin = static_cast<T>(std::min(t1, n));
+            auto const tmin = std::min(t1, n);
             for (auto m = i; m < tmin; m++) { output[k] += signal[m] * patch[k - m]; }
         }
         return;
@@ -50,8 +55,20 @@ auto convolute(Span<T const> signal, Span<T const> patch, T* output) noexcept ->
         output[k] = 0.0;
         i++;
         auto const t1   = n + i;
-        auto const tmin = static_cast<T>(std::min(t1, l));
+        auto const tmin = std::min(t1, l);
         for (auto m = i; m < tmin; m++) { output[k] += patch[m] * signal[k - m]; }
     }
 }
+
+/// Full linear convolution, writes signal.size() + patch.size() - 1 samples. Floats run
+/// the vectorized kernels of convoluteDirect.
+template<typename T>
+auto convolute(Span<T const> signal, Span<T const> patch, T* output) noexcept -> void
+{
+    if constexpr (std::is_same_v<T, float>) {
+        convoluteDirect(signal, patch, output);
+    } else {
+        convoluteScalar(signal, patch, output);
+    }
+}
 }  // namespace mc
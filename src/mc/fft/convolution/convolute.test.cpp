@@ -36,3 +36,65 @@ TEST_CASE("fft/convolution: convolute", "[fft][convolution]")
     // CHECK(testConvolute<double>(testData));
     CHECK(testConvolute<float>(toFloat(testData)));
 }
+
+TEST_CASE("fft/convolution: FFTConvolver", "[fft][convolution]")
+{
+    auto const* const testFile = GENERATE(
+        "test_data/raw/conv_xcorr_01.txt",
+        "test_data/raw/conv_xcorr_02.txt",
+        "test_data/raw/conv_xcorr_03.txt",
+        "test_data/raw/conv_xcorr_04.txt"
+    );
+
+    auto const testData = toFloat(loadTestData(testFile));
+    auto const& signal   = testData[0];
+    auto const& patch    = testData[1];
+    auto const& expected = testData[2];
+
+    auto convolver = FFTConvolver{signal.size(), patch.size()};
+    auto output    = Vector<float>(expected.size());
+    convolver.convolute(signal, patch, data(output));
+    CHECK(approxEqual<float>(output, expected));
+
+    // A second bound patch must not disturb the first one
+    auto const reversed = Vector<float>(patch.rbegin(), patch.rend());
+    auto const first    = convolver.bindPatch(patch);
+    auto const second   = convolver.bindPatch(reversed);
+    CHECK(convolver.boundPatches() == 2U);
+
+    for (auto i = 0; i < 2; ++i) {
+        ranges::fill(output, 0.0F);
+        convolver.convolute(signal, first, data(output));
+        CHECK(approxEqual<float>(output, expected));
+    }
+
+    auto direct = Vector<float>(expected.size());
+    convolute<float>(signal, reversed, data(direct));
+    convolver.convolute(signal, second, data(output));
+    CHECK(approxEqual<float>(output, direct));
+}
+
+TEST_CASE("fft/convolution: FFTConvolver non power of two", "[fft][convolution]")
+{
+    auto const signalSize = GENERATE(as<size_t>{}, 1U, 100U, 1030U, 4100U);
+    auto const patchSize  = GENERATE(as<size_t>{}, 1U, 7U, 64U);
+
+    auto signal = Vector<float>(signalSize);
+    auto patch  = Vector<float>(patchSize);
+    for (auto i = size_t{0}; i < signalSize; ++i) {
+        signal[i] = std::sin(0.01F * static_cast<float>(i));
+    }
+    for (auto i = size_t{0}; i < patchSize; ++i) {
+        patch[i] = 1.0F / (1.0F + static_cast<float>(i));
+    }
+
+    auto expected = Vector<float>(signalSize + patchSize - 1U);
+    convolute<float>(signal, patch, data(expected));
+
+    auto convolver = FFTConvolver{signalSize, patchSize};
+    auto output    = Vector<float>(expected.size());
+    convolver.convolute(signal, convolver.bindPatch(patch), data(output));
+    CHECK(ranges::equal(output, expected, [](auto l, auto r) {
+        return std::abs(l - r) < 1e-3F;
+    }));
+}
@@ -0,0 +1,257 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "convolution_cost_model.hpp"
+
+#include <mc/fft/convolution/convolute.hpp>
+#include <mc/fft/convolution/fft_convolver.hpp>
+#include <mc/fft/convolution/overlap_save_convolver.hpp>
+#include <mc/fft/transform/backend/pffft.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/bit.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/chrono.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/fstream.hpp>
+#include <mc/core/limits.hpp>
+#include <mc/core/mutex.hpp>
+#include <mc/core/optional.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+namespace {
+
+// First line of a saved model, bump the version if the units change.
+constexpr auto const* modelHeader = "mc-convolution-cost-model 1";
+
+struct ModelState
+{
+    std::mutex mutex;
+    Optional<ConvolutionCostModel> model;
+};
+
+auto modelState() -> ModelState&
+{
+    static auto state = ModelState{};
+    return state;
+}
+
+[[nodiscard]] auto transformUnits(size_t n) -> double
+{
+    auto const size = static_cast<double>(n);
+    return size * std::log2(std::max(size, 2.0));
+}
+
+[[nodiscard]] auto directUnits(size_t signalSize, size_t patchSize) -> double
+{
+    return static_cast<double>(signalSize) * static_cast<double>(patchSize);
+}
+
+[[nodiscard]] auto fftUnits(size_t signalSize, size_t patchSize) -> double
+{
+    auto const size = pffftFastSize(signalSize + patchSize - 1, TransformKind::real);
+    return transformUnits(size);
+}
+
+// Chunking as in OverlapSaveConvolver
+[[nodiscard]] auto overlapSaveUnits(size_t signalSize, size_t patchSize) -> double
+{
+    auto const chunkSize = 2 * bit_ceil(patchSize);
+    auto const stride    = chunkSize - patchSize + 1;
+    auto const chunks    = (signalSize + patchSize - 1 + stride - 1) / stride;
+    return static_cast<double>(chunks) * transformUnits(chunkSize);
+}
+
+// Fastest of a few runs, in nanoseconds
+template<typename Func>
+[[nodiscard]] auto measure(Func func) -> double
+{
+    func();
+
+    auto best = std::numeric_limits<double>::max();
+    for (auto i = 0; i < 5; ++i) {
+        auto const start = std::chrono::steady_clock::now();
+        func();
+        auto const stop    = std::chrono::steady_clock::now();
+        auto const elapsed = std::chrono::duration<double, std::nano>(stop - start);
+        best               = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+[[nodiscard]] auto ramp(size_t size) -> Vector<float>
+{
+    auto result = Vector<float>(size);
+    for (auto i = size_t{0}; i < size; ++i) {
+        result[i] = std::sin(0.01F * static_cast<float>(i));
+    }
+    return result;
+}
+
+}  // namespace
+
+auto estimateConvolutionCost(
+    ConvolutionCostModel const& model,
+    ConvolutionMethod method,
+    size_t signalSize,
+    size_t patchSize
+) -> double
+{
+    MC_ASSERT(method != ConvolutionMethod::automatic);
+
+    if (method == ConvolutionMethod::direct) {
+        return model.direct * directUnits(signalSize, patchSize);
+    }
+    if (method == ConvolutionMethod::overlapSave) {
+        if (patchSize > signalSize) { return std::numeric_limits<double>::infinity(); }
+        return model.overlapSave * overlapSaveUnits(signalSize, patchSize);
+    }
+    return model.fft * fftUnits(signalSize, patchSize);
+}
+
+auto calibrateConvolutionCostModel() -> ConvolutionCostModel
+{
+    auto model = ConvolutionCostModel{};
+
+    {
+        auto const signal = ramp(2048);
+        auto const patch  = ramp(32);
+        auto output       = Vector<float>(signal.size() + patch.size() - 1);
+
+        auto const run = [&] { convolute<float>(signal, patch, output.data()); };
+        model.direct   = measure(run) / directUnits(signal.size(), patch.size());
+    }
+
+    {
+        auto const signal = ramp(4096);
+        auto const patch  = ramp(512);
+        auto output       = Vector<float>(signal.size() + patch.size() - 1);
+        auto convolver    = FFTConvolver{signal.size(), patch.size()};
+
+        auto const run = [&] { convolver.convolute(signal, patch, output.data()); };
+        model.fft      = measure(run) / fftUnits(signal.size(), patch.size());
+    }
+
+    {
+        auto signalData = ramp(8192);
+        auto patchData  = ramp(128);
+        auto signal     = FloatSignal{signalData.data(), signalData.size()};
+        auto patch      = FloatSignal{patchData.data(), patchData.size()};
+        auto output     = Vector<float>(signal.size() + patch.size() - 1);
+        auto convolver  = OverlapSaveConvolver{signal, patch};
+
+        auto const run    = [&] { convolver.convolute(output); };
+        model.overlapSave = measure(run) / overlapSaveUnits(signal.size(), patch.size());
+    }
+
+    return model;
+}
+
+auto convolutionCostModel() -> ConvolutionCostModel
+{
+    auto& state     = modelState();
+    auto const lock = std::scoped_lock{state.mutex};
+    if (!state.model) { state.model = calibrateConvolutionCostModel(); }
+    return *state.model;
+}
+
+auto setConvolutionCostModel(ConvolutionCostModel const& model) -> void
+{
+    auto& state     = modelState();
+    auto const lock = std::scoped_lock{state.mutex};
+    state.model     = model;
+}
+
+auto loadConvolutionCostModel(String const& path) -> bool
+{
+    auto in     = std::ifstream{path.c_str()};
+    auto header = String{};
+    if (!std::getline(in, header) || header != modelHeader) { return false; }
+
+    auto direct      = Optional<double>{};
+    auto fft         = Optional<double>{};
+    auto overlapSave = Optional<double>{};
+
+    auto name  = String{};
+    auto value = 0.0;
+    while (in >> name >> value) {
+        auto* field = static_cast<Optional<double>*>(nullptr);
+        if (name == "direct") { field = &direct; }
+        if (name == "fft") { field = &fft; }
+        if (name == "overlap-save") { field = &overlapSave; }
+        if (field == nullptr || field->has_value() || !(value > 0.0)) { return false; }
+        *field = value;
+    }
+
+    // Stopped on a malformed line instead of the end of the file
+    if (!in.eof() || !direct || !fft || !overlapSave) { return false; }
+
+    setConvolutionCostModel(ConvolutionCostModel{*direct, *fft, *overlapSave});
+    return true;
+}
+
+auto saveConvolutionCostModel(String const& path) -> bool
+{
+    auto const model = convolutionCostModel();
+
+    auto out = std::ofstream{path.c_str()};
+    out << modelHeader << '\n';
+    out << "direct " << model.direct << '\n';
+    out << "fft " << model.fft << '\n';
+    out << "overlap-save " << model.overlapSave << '\n';
+    return static_cast<bool>(out);
+}
+
+auto selectConvolutionMethod(size_t signalSize, size_t patchSize) -> ConvolutionMethod
+{
+    auto const model = convolutionCostModel();
+
+    auto best     = ConvolutionMethod::direct;
+    auto bestCost = estimateConvolutionCost(model, best, signalSize, patchSize);
+    for (auto method : {ConvolutionMethod::fft, ConvolutionMethod::overlapSave}) {
+        auto const cost = estimateConvolutionCost(model, method, signalSize, patchSize);
+        if (cost < bestCost) {
+            best     = method;
+            bestCost = cost;
+        }
+    }
+    return best;
+}
+
+auto convolute(
+    ConvolutionMethod method,
+    Span<float const> signal,
+    Span<float const> patch,
+    float* output
+) -> void
+{
+    if (method == ConvolutionMethod::automatic) {
+        method = selectConvolutionMethod(signal.size(), patch.size());
+    }
+
+    if (method == ConvolutionMethod::direct) {
+        convolute<float>(signal, patch, output);
+        return;
+    }
+
+    if (method == ConvolutionMethod::fft) {
+        auto convolver = FFTConvolver{signal.size(), patch.size()};
+        convolver.convolute(signal, patch, output);
+        return;
+    }
+
+    // Overlap-save needs the longer input as signal, convolution commutes
+    auto const& longer  = patch.size() > signal.size() ? patch : signal;
+    auto const& shorter = patch.size() > signal.size() ? signal : patch;
+
+    auto signalCopy = FloatSignal{longer.size()};
+    auto patchCopy  = FloatSignal{shorter.size()};
+    ranges::copy(longer, signalCopy.begin());
+    ranges::copy(shorter, patchCopy.begin());
+
+    auto convolver = OverlapSaveConvolver{signalCopy, patchCopy};
+    convolver.convolute({output, signal.size() + patch.size() - 1});
+}
+
+}  // namespace mc
@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/convolution/convolution_method.hpp>
+
+#include <mc/core/cstddef.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/string.hpp>
+
+namespace mc {
+
+/// Run time of the convolution methods on this host, in nanoseconds per unit of work:
+/// a multiply-add for direct, N * log2(N) of the padded transform for fft & the same
+/// summed over all chunks for overlapSave.
+struct ConvolutionCostModel
+{
+    double direct{0.5};
+    double fft{2.0};
+    double overlapSave{3.0};
+};
+
+/// Estimated nanoseconds of a full convolution. Infinite if the method can't handle the
+/// sizes, e.g. overlapSave with a patch longer than the signal.
+[[nodiscard]] auto estimateConvolutionCost(
+    ConvolutionCostModel const& model,
+    ConvolutionMethod method,
+    size_t signalSize,
+    size_t patchSize
+) -> double;
+
+/// Times every method on a few small problems & fits the model. Takes a few
+/// milliseconds in optimized builds.
+[[nodiscard]] auto calibrateConvolutionCostModel() -> ConvolutionCostModel;
+
+/// Process wide model used by ConvolutionMethod::automatic. Calibrated on first use,
+/// unless a model was set or loaded before.
+[[nodiscard]] auto convolutionCostModel() -> ConvolutionCostModel;
+auto setConvolutionCostModel(ConvolutionCostModel const& model) -> void;
+
+/// Reads a model written by saveConvolutionCostModel & makes it the process wide model.
+/// Every line after the header is a "key value" pair, in any order. Returns false &
+/// keeps the current model if the file does not exist, a key is unknown, repeated or
+/// missing, or a value isn't positive.
+auto loadConvolutionCostModel(String const& path) -> bool;
+
+/// Writes the process wide model, calibrating it first if necessary.
+auto saveConvolutionCostModel(String const& path) -> bool;
+
+/// Cheapest of direct, fft & overlapSave for the sizes under the process wide model.
+[[nodiscard]] auto selectConvolutionMethod(size_t signalSize, size_t patchSize)
+    -> ConvolutionMethod;
+
+/// Full convolution of signal & patch into signal.size() + patch.size() - 1 samples.
+/// Convenience for one-off calls, the FFT based methods plan & allocate on every call.
+auto convolute(
+    ConvolutionMethod method,
+    Span<float const> signal,
+    Span<float const> patch,
+    float* output
+) -> void;
+
+}  // namespace mc
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft/convolution.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/filesystem.hpp>
+#include <mc/core/fstream.hpp>
+#include <mc/core/limits.hpp>
+#include <mc/core/string.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft/convolution: estimateConvolutionCost", "[fft][convolution]")
+{
+    auto const model = ConvolutionCostModel{};
+
+    auto const cost = [&model](auto method, size_t signal, size_t patch) {
+        return estimateConvolutionCost(model, method, signal, patch);
+    };
+
+    auto const direct      = ConvolutionMethod::direct;
+    auto const fft         = ConvolutionMethod::fft;
+    auto const overlapSave = ConvolutionMethod::overlapSave;
+
+    // Short filters favor direct, long ones the transforms
+    CHECK(cost(direct, 4096, 4) < cost(fft, 4096, 4));
+    CHECK(cost(fft, 65536, 4096) < cost(direct, 65536, 4096));
+    CHECK(cost(overlapSave, 16, 32) == std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("fft/convolution: ConvolutionMethod::automatic", "[fft][convolution]")
+{
+    auto const model = calibrateConvolutionCostModel();
+    CHECK(model.direct > 0.0);
+    CHECK(model.fft > 0.0);
+    CHECK(model.overlapSave > 0.0);
+    setConvolutionCostModel(model);
+
+    auto const file = std::filesystem::temp_directory_path() / "mc-convolution-model.txt";
+    auto const path = file.string();
+    REQUIRE(saveConvolutionCostModel(path));
+    setConvolutionCostModel(ConvolutionCostModel{});
+    REQUIRE(loadConvolutionCostModel(path));
+    REQUIRE_FALSE(loadConvolutionCostModel(path + ".does-not-exist"));
+    std::filesystem::remove(file);
+
+    auto const loaded = convolutionCostModel();
+    CHECK(std::abs(loaded.direct / model.direct - 1.0) < 1e-4);
+    CHECK(std::abs(loaded.fft / model.fft - 1.0) < 1e-4);
+    CHECK(std::abs(loaded.overlapSave / model.overlapSave - 1.0) < 1e-4);
+
+    auto const [signalSize, patchSize] = GENERATE(
+        std::pair{size_t{1000}, size_t{3}},
+        std::pair{size_t{4096}, size_t{1024}},
+        std::pair{size_t{300}, size_t{2000}}
+    );
+
+    auto const method = selectConvolutionMethod(signalSize, patchSize);
+    CHECK(method != ConvolutionMethod::automatic);
+
+    auto const signal = generateRandomTestData(signalSize);
+    auto const patch  = generateRandomTestData(patchSize);
+    auto expected     = Vector<float>(signalSize + patchSize - 1);
+    convolute<float>(signal, patch, data(expected));
+
+    auto const isClose = [](auto l, auto r) { return std::abs(l - r) < 1e-3F; };
+    for (auto m : {ConvolutionMethod::automatic, ConvolutionMethod::overlapSave}) {
+        auto output = Vector<float>(expected.size());
+        convolute(m, signal, patch, data(output));
+        CHECK(ranges::equal(output, expected, isClose));
+    }
+}
+
+TEST_CASE("fft/convolution: loadConvolutionCostModel", "[fft][convolution]")
+{
+    auto const file = std::filesystem::temp_directory_path() / "mc-convolution-load.txt";
+    auto const path = file.string();
+
+    auto const load = [&path](char const* content) {
+        std::ofstream{path.c_str()} << content;
+        return loadConvolutionCostModel(path);
+    };
+
+    auto const model = ConvolutionCostModel{1.0, 2.0, 3.0};
+    setConvolutionCostModel(model);
+
+    // Any order
+    REQUIRE(load("mc-convolution-cost-model 1\nfft 5\noverlap-save 6\ndirect 4\n"));
+    CHECK(convolutionCostModel().direct == 4.0);
+    CHECK(convolutionCostModel().fft == 5.0);
+    CHECK(convolutionCostModel().overlapSave == 6.0);
+    setConvolutionCostModel(model);
+
+    CHECK_FALSE(load("mc-convolution-cost-model 2\ndirect 4\nfft 5\noverlap-save 6\n"));
+    CHECK_FALSE(load("mc-convolution-cost-model 1\ndirect 4\nfft 5\n"));
+    CHECK_FALSE(load("mc-convolution-cost-model 1\ndirect 4\nfft 5\nfft 6\n"));
+    CHECK_FALSE(load("mc-convolution-cost-model 1\ndirect 4\nfft 5\nsave 6\n"));
+    CHECK_FALSE(load("mc-convolution-cost-model 1\ndirect 4\nfft 5\noverlap-save x\n"));
+    CHECK_FALSE(load("mc-convolution-cost-model 1\ndirect 4\nfft 0\noverlap-save 6\n"));
+    CHECK(convolutionCostModel().direct == model.direct);
+    CHECK(convolutionCostModel().fft == model.fft);
+    CHECK(convolutionCostModel().overlapSave == model.overlapSave);
+
+    std::filesystem::remove(file);
+}
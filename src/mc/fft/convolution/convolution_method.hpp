@@ -11,11 +11,17 @@ enum struct ConvolutionMethod
 {
     direct,
     fft,
+    overlapSave,
+
+    /// Cheapest of the above per signal & patch size, see selectConvolutionMethod.
+    automatic,
 };
 
 [[nodiscard]] inline auto toString(ConvolutionMethod method) -> String
 {
     if (method == ConvolutionMethod::direct) { return "direct"; }
+    if (method == ConvolutionMethod::overlapSave) { return "overlap-save"; }
+    if (method == ConvolutionMethod::automatic) { return "automatic"; }
     return "fft";
 }
 }  // namespace mc
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "direct_convolution.hpp"
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/transform/simd.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/array.hpp>
+#include <mc/core/utility.hpp>
+
+namespace mc {
+
+namespace {
+
+// Outputs per block, two AVX or four SSE/NEON registers of independent accumulators
+constexpr auto lanes = size_t{16};
+
+using Kernel = auto (*)(float const*, float const*, size_t, float*, size_t, size_t) -> void;
+
+// out[k] = sum_m patch[m] * signal[k - m] for k in [first, last), where the whole patch
+// overlaps the signal. Taps == 0 reads the patch length at runtime. The lane loop is
+// left to the vectorizer, a fixed tap count keeps the accumulators in registers.
+template<size_t Taps>
+MC_FFT_ALWAYS_INLINE auto valid(
+    float const* signal,
+    float const* patch,
+    size_t taps,
+    float* out,
+    size_t first,
+    size_t last
+) -> void
+{
+    auto const n = Taps == 0 ? taps : Taps;
+
+    auto k = first;
+    for (; k + lanes <= last; k += lanes) {
+        auto acc = Array<float, lanes>{};
+        for (auto m = size_t{0}; m < n; ++m) {
+            auto const c  = patch[m];
+            auto const* s = signal + k - m;
+            for (auto j = size_t{0}; j < lanes; ++j) { acc[j] += c * s[j]; }
+        }
+        for (auto j = size_t{0}; j < lanes; ++j) { out[k + j] = acc[j]; }
+    }
+
+    for (; k < last; ++k) {
+        auto sum = 0.0F;
+        for (auto m = size_t{0}; m < n; ++m) { sum += patch[m] * signal[k - m]; }
+        out[k] = sum;
+    }
+}
+
+#if MC_FFT_HAS_TARGET_ATTRIBUTE
+template<size_t Taps>
+MC_FFT_TARGET("avx2,fma")
+auto validAVX2(
+    float const* signal,
+    float const* patch,
+    size_t taps,
+    float* out,
+    size_t first,
+    size_t last
+) -> void
+{
+    valid<Taps>(signal, patch, taps, out, first, last);
+}
+#endif
+
+template<size_t Taps>
+auto kernel(bool avx2) -> Kernel
+{
+#if MC_FFT_HAS_TARGET_ATTRIBUTE
+    if (avx2) { return validAVX2<Taps>; }
+#endif
+    (void)avx2;
+    return valid<Taps>;
+}
+
+// db1-db10 & sym2-sym10 have 2 to 20 taps, coif1-coif5 6 to 30 in steps of 6
+auto selectKernel(size_t taps, bool avx2) -> Kernel
+{
+    switch (taps) {
+        case 2: return kernel<2>(avx2);
+        case 4: return kernel<4>(avx2);
+        case 6: return kernel<6>(avx2);
+        case 8: return kernel<8>(avx2);
+        case 10: return kernel<10>(avx2);
+        case 12: return kernel<12>(avx2);
+        case 14: return kernel<14>(avx2);
+        case 16: return kernel<16>(avx2);
+        case 18: return kernel<18>(avx2);
+        case 20: return kernel<20>(avx2);
+        case 24: return kernel<24>(avx2);
+        case 30: return kernel<30>(avx2);
+        default: return kernel<0>(avx2);
+    }
+}
+
+// Outputs the patch only partially overlaps, at most taps - 1 on either end
+auto partial(
+    float const* signal,
+    size_t signalSize,
+    float const* patch,
+    size_t taps,
+    float* out,
+    size_t first,
+    size_t last
+) -> void
+{
+    for (auto k = first; k < last; ++k) {
+        auto const mFirst = k >= signalSize ? k - signalSize + 1 : size_t{0};
+        auto const mLast  = std::min(k + 1, taps);
+
+        auto sum = 0.0F;
+        for (auto m = mFirst; m < mLast; ++m) { sum += patch[m] * signal[k - m]; }
+        out[k] = sum;
+    }
+}
+
+}  // namespace
+
+auto convoluteDirect(
+    Span<float const> signal,
+    Span<float const> patch,
+    float* output
+) noexcept -> void
+{
+    if (signal.empty() || patch.empty()) { return; }
+
+    // Convolution commutes, the kernels need the patch to be the shorter input
+    if (signal.size() < patch.size()) { std::swap(signal, patch); }
+
+    auto const s     = signal.size();
+    auto const taps  = patch.size();
+    auto const total = s + taps - 1;
+
+#if MC_FFT_HAS_TARGET_ATTRIBUTE
+    auto const avx2 = simdLevel() == SimdLevel::avx2;
+#else
+    auto const avx2 = false;
+#endif
+
+    partial(signal.data(), s, patch.data(), taps, output, 0, taps - 1);
+    selectKernel(taps, avx2)(signal.data(), patch.data(), taps, output, taps - 1, s);
+    partial(signal.data(), s, patch.data(), taps, output, s, total);
+}
+
+}  // namespace mc
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/cstddef.hpp>
+#include <mc/core/span.hpp>
+
+namespace mc {
+
+/// Full linear convolution, writes signal.size() + patch.size() - 1 samples. Outputs
+/// covered by the whole patch are computed 16 at a time, with the tap loop unrolled for
+/// the lengths of the db, sym & coif wavelet filters and a generic loop for all others.
+/// Runs the widest kernel allowed by simdLevel(). Does nothing if an input is empty.
+auto convoluteDirect(
+    Span<float const> signal,
+    Span<float const> patch,
+    float* output
+) noexcept -> void;
+
+}  // namespace mc
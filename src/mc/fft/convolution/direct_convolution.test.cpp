@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft/convolution.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft/convolution: convoluteDirect", "[fft][convolution]")
+{
+    auto const signalSize = GENERATE(size_t{1}, size_t{7}, size_t{40}, size_t{1000});
+    auto const patchSize  = GENERATE(
+        size_t{1},
+        size_t{2},
+        size_t{4},
+        size_t{6},
+        size_t{12},
+        size_t{17},
+        size_t{20},
+        size_t{30},
+        size_t{76}
+    );
+
+    auto signal = Vector<float>(signalSize);
+    auto patch  = Vector<float>(patchSize);
+    for (auto i = size_t{0}; i < signalSize; ++i) {
+        signal[i] = std::sin(static_cast<float>(i) * 0.3F);
+    }
+    for (auto i = size_t{0}; i < patchSize; ++i) {
+        patch[i] = std::cos(static_cast<float>(i) * 0.7F);
+    }
+
+    auto expected = Vector<float>(signalSize + patchSize - 1);
+    auto output   = Vector<float>(signalSize + patchSize - 1);
+    convoluteScalar<float>(signal, patch, expected.data());
+
+    auto const near = [](float a, float b) { return std::abs(a - b) < 1e-4F; };
+
+    convoluteDirect(signal, patch, output.data());
+    CHECK(ranges::equal(output, expected, near));
+
+    convoluteDirect(patch, signal, output.data());
+    CHECK(ranges::equal(output, expected, near));
+
+    forceSimdLevel(SimdLevel::scalar);
+    convoluteDirect(signal, patch, output.data());
+    resetSimdLevel();
+    CHECK(ranges::equal(output, expected, near));
+}
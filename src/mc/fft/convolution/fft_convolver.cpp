@@ -2,11 +2,10 @@
 
 #include "fft_convolver.hpp"
 
-#include <mc/fft/algorithm/spectral_convolution.hpp>
-
 #include <mc/core/algorithm.hpp>
-#include <mc/core/bit.hpp>
+#include <mc/core/cassert.hpp>
 #include <mc/core/cmath.hpp>
+#include <mc/core/iterator.hpp>
 #include <mc/core/memory.hpp>
 
 namespace mc {
@@ -14,8 +13,8 @@ namespace mc {
 FFTConvolver::FFTConvolver(size_t signalSize, size_t patchSize)
     : _signalSize{signalSize}
     , _patchSize{patchSize}
-    , _totalSize{bit_ceil(signalSize + _patchSize - 1U)}
-    , _fft{makeRFFT(_totalSize)}
+    , _totalSize{pffftFastSize(signalSize + _patchSize - 1U, TransformKind::real)}
+    , _fft{_totalSize}
 {
     _signalScratch.resize(_totalSize);
     _signalScratchOut.resize(_totalSize);
@@ -25,34 +24,70 @@ FFTConvolver::FFTConvolver(size_t signalSize, size_t patchSize)
     _tmpOut.resize(_totalSize);
 }
 
+auto FFTConvolver::signalSize() const noexcept -> size_t { return _signalSize; }
+
+auto FFTConvolver::patchSize() const noexcept -> size_t { return _patchSize; }
+
+auto FFTConvolver::boundPatches() const noexcept -> size_t { return _patches.size(); }
+
+auto FFTConvolver::bindPatch(Span<float const> patch) -> size_t
+{
+    MC_ASSERT(patch.size() >= _patchSize);
+
+    auto const first = patch.begin();
+    auto const last  = std::next(first, static_cast<ptrdiff_t>(_patchSize));
+    std::copy(first, last, _patchScratch.begin());
+
+    auto& spectrum = _patches.emplace_back(_totalSize);
+    _fft.forward(_patchScratch, spectrum);
+    return _patches.size() - 1U;
+}
+
+auto FFTConvolver::convolute(Span<float const> signal, size_t patch, float* output) -> void
+{
+    MC_ASSERT(patch < _patches.size());
+    convoluteSpectrum(signal, _patches[patch], output);
+}
+
 auto FFTConvolver::convolute(
     Span<float const> signal,
     Span<float const> patch,
     float* output
 ) -> void
 {
-    ranges::fill(_signalScratch, 0.0F);
-    ranges::fill(_patchScratch, 0.0F);
-    ranges::fill(_tmp, 0.0F);
+    MC_ASSERT(patch.size() >= _patchSize);
 
-    ranges::fill(_signalScratchOut, Complex<float>{});
-    ranges::fill(_patchScratchOut, Complex<float>{});
-    ranges::fill(_tmpOut, 0.0F);
+    auto const first = patch.begin();
+    auto const last  = std::next(first, static_cast<ptrdiff_t>(_patchSize));
+    std::copy(first, last, _patchScratch.begin());
 
-    for (auto i = size_t{0}; i < _totalSize; i++) {
-        if (i < _signalSize) { _signalScratch[i] = signal[i]; }
-        if (i < _patchSize) { _patchScratch[i] = patch[i]; }
-    }
+    _fft.forward(_patchScratch, _patchScratchOut);
+    convoluteSpectrum(signal, _patchScratchOut, output);
+}
 
-    rfft(_fft, _signalScratch, _signalScratchOut);
-    rfft(_fft, _patchScratch, _patchScratchOut);
+auto FFTConvolver::convoluteSpectrum(
+    Span<float const> signal,
+    Span<float const> patch,
+    float* output
+) -> void
+{
+    MC_ASSERT(signal.size() >= _signalSize);
+
+    auto const first = signal.begin();
+    auto const last  = std::next(first, static_cast<ptrdiff_t>(_signalSize));
+    std::copy(first, last, _signalScratch.begin());
 
-    spectralConvolution(_signalScratchOut, _patchScratchOut, _tmp);
+    _fft.forward(_signalScratch, _signalScratchOut);
+
+    // The 1/N normalization is folded into the spectral product.
+    auto const scale = 1.0F / static_cast<float>(_totalSize);
+    ranges::fill(_tmp, 0.0F);
+    _fft.convolveAccumulate(_signalScratchOut, patch, _tmp, scale);
 
-    irfft(_fft, _tmp, _tmpOut);
+    _fft.backward(_tmp, _tmpOut);
 
-    auto const ls = _signalSize + _patchSize - 1U;
-    for (auto i = size_t{0}; i < ls; i++) { output[i] = _tmpOut[i] / _totalSize; }
+    auto const ls = static_cast<ptrdiff_t>(_signalSize + _patchSize - 1U);
+    std::copy(_tmpOut.begin(), std::next(_tmpOut.begin(), ls), output);
 }
 
 }  // namespace mc
@@ -9,29 +9,54 @@
 #include <mc/core/vector.hpp>
 
 namespace mc {
+
+/// Full linear convolution of a signal & a patch of fixed sizes. A fixed patch, e.g. a
+/// filter, can be bound once with bindPatch. Convolving with a bound patch costs one
+/// forward & one inverse transform.
 struct FFTConvolver
 {
     using value_type = float;
 
     FFTConvolver(size_t signalSize, size_t patchSize);
 
+    [[nodiscard]] auto signalSize() const noexcept -> size_t;
+    [[nodiscard]] auto patchSize() const noexcept -> size_t;
+
+    /// Precomputes the spectrum of a patch of patchSize() samples. Returns the index to
+    /// pass to convolute, patches stay bound for the lifetime of the convolver.
+    auto bindPatch(Span<float const> patch) -> size_t;
+
+    /// Number of patches bound with bindPatch.
+    [[nodiscard]] auto boundPatches() const noexcept -> size_t;
+
+    /// Convolves with a patch bound by bindPatch.
+    auto convolute(Span<float const> signal, size_t patch, float* output) -> void;
+
+    /// Transforms the patch on every call, prefer bindPatch for a fixed patch.
     auto convolute(Span<float const> signal, Span<float const> patch, float* output)
         -> void;
 
 private:
+    auto convoluteSpectrum(Span<float const> signal, Span<float const> patch, float* output)
+        -> void;
+
     size_t _signalSize;
     size_t _patchSize;
     size_t _totalSize;
 
-    RFFT<float> _fft;
+    // Spectra are only multiplied and transformed back, so they are kept in pffft's
+    // internal order.
+    PFFFT_Convolution_Float _fft;
+    Vector<AlignedVector<float>> _patches{};
 
-    Vector<float> _signalScratch{};
-    Vector<Complex<float>> _signalScratchOut{};
+    // The zero padding behind the signal & patch is written once by the constructor.
+    AlignedVector<float> _signalScratch{};
+    AlignedVector<float> _signalScratchOut{};
 
-    Vector<float> _patchScratch{};
-    Vector<Complex<float>> _patchScratchOut{};
+    AlignedVector<float> _patchScratch{};
+    AlignedVector<float> _patchScratchOut{};
 
-    Vector<Complex<float>> _tmp{};
-    Vector<float> _tmpOut{};
+    AlignedVector<float> _tmp{};
+    AlignedVector<float> _tmpOut{};
 };
 }  // namespace mc
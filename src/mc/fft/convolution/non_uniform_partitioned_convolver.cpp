@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "non_uniform_partitioned_convolver.hpp"
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/condition_variable.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/iterator.hpp>
+#include <mc/core/mutex.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/thread.hpp>
+
+namespace mc {
+
+namespace {
+
+// Block size of a stage relative to the previous one
+constexpr auto stageGrowth = size_t{4};
+
+// Stages stop growing here, the last one takes the rest of the filter
+constexpr auto maxStageBlockSize = size_t{1} << 16U;
+
+auto checkBlockSize(Span<float const> filter, size_t blockSize) -> size_t
+{
+    if (filter.empty()) { raise<InvalidArgument>("partitioned convolver: empty filter"); }
+    if (blockSize == 0) {
+        raise<InvalidArgument>("partitioned convolver: block size must not be zero");
+    }
+    return blockSize;
+}
+
+// The first stage starts at twice its block size
+[[nodiscard]] auto headSize(Span<float const> filter, size_t blockSize) -> size_t
+{
+    return std::min(filter.size(), 2 * stageGrowth * checkBlockSize(filter, blockSize));
+}
+
+}  // namespace
+
+struct NonUniformPartitionedConvolver::Stage
+{
+    Stage(Span<float const> filter, size_t blockSize)
+        : convolver{filter, blockSize}
+        , input(blockSize)
+        , jobInput(blockSize)
+        , jobOutput(blockSize)
+        , worker{[this] { run(); }}
+    {}
+
+    ~Stage()
+    {
+        {
+            auto const lock = std::scoped_lock{mutex};
+            stop            = true;
+        }
+        condition.notify_all();
+        worker.join();
+    }
+
+    Stage(Stage const& other)                    = delete;
+    auto operator=(Stage const& other) -> Stage& = delete;
+
+    [[nodiscard]] auto blockSize() const noexcept -> size_t { return input.size(); }
+
+    auto post() -> void
+    {
+        ranges::copy(input, jobInput.begin());
+        {
+            auto const lock = std::scoped_lock{mutex};
+            busy            = true;
+        }
+        posted = true;
+        condition.notify_all();
+    }
+
+    auto wait() -> void
+    {
+        auto lock = std::unique_lock{mutex};
+        condition.wait(lock, [this] { return !busy; });
+    }
+
+    auto run() -> void
+    {
+        auto lock = std::unique_lock{mutex};
+        while (true) {
+            condition.wait(lock, [this] { return busy || stop; });
+            if (stop) { return; }
+
+            lock.unlock();
+            convolver.process(jobInput, jobOutput);
+            lock.lock();
+
+            busy = false;
+            condition.notify_all();
+        }
+    }
+
+    UniformPartitionedConvolver convolver;
+
+    // Owned by the caller's thread
+    Vector<float> input;
+    bool posted{false};
+
+    // Owned by the worker while busy
+    Vector<float> jobInput;
+    Vector<float> jobOutput;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool busy{false};
+    bool stop{false};
+
+    // Started last, all other members are initialized
+    std::thread worker;
+};
+
+NonUniformPartitionedConvolver::NonUniformPartitionedConvolver(
+    Span<float const> filter,
+    size_t blockSize
+)
+    : _blockSize{blockSize}
+    , _filterSize{filter.size()}
+    , _head{filter.first(headSize(filter, blockSize)), blockSize}
+{
+    auto offset = headSize(filter, blockSize);
+    auto size   = stageGrowth * blockSize;
+    while (offset < filter.size()) {
+        MC_ASSERT(offset == 2 * size);
+
+        auto length = std::min(filter.size() - offset, 2 * (stageGrowth - 1) * size);
+        if (size >= maxStageBlockSize) { length = filter.size() - offset; }
+
+        _tail.push_back(makeUnique<Stage>(filter.subspan(offset, length), size));
+        offset += length;
+        size *= stageGrowth;
+    }
+
+    auto const largest = _tail.empty() ? blockSize : _tail.back()->blockSize();
+    _pending.resize(largest);
+}
+
+NonUniformPartitionedConvolver::~NonUniformPartitionedConvolver() = default;
+
+NonUniformPartitionedConvolver::NonUniformPartitionedConvolver(
+    NonUniformPartitionedConvolver&& other
+) noexcept = default;
+
+auto NonUniformPartitionedConvolver::operator=(NonUniformPartitionedConvolver&& other
+) noexcept -> NonUniformPartitionedConvolver& = default;
+
+auto NonUniformPartitionedConvolver::blockSize() const noexcept -> size_t
+{
+    return _blockSize;
+}
+
+auto NonUniformPartitionedConvolver::filterSize() const noexcept -> size_t
+{
+    return _filterSize;
+}
+
+auto NonUniformPartitionedConvolver::stages() const noexcept -> size_t
+{
+    return _tail.size() + 1;
+}
+
+auto NonUniformPartitionedConvolver::stageBlockSize(size_t stage) const -> size_t
+{
+    MC_ASSERT(stage < stages());
+    return stage == 0 ? _blockSize : _tail[stage - 1]->blockSize();
+}
+
+auto NonUniformPartitionedConvolver::reset() -> void
+{
+    for (auto& stage : _tail) {
+        stage->wait();
+        stage->convolver.reset();
+        stage->posted = false;
+    }
+    _head.reset();
+    ranges::fill(_pending, 0.0F);
+    _time = 0;
+}
+
+auto NonUniformPartitionedConvolver::process(Span<float const> input, Span<float> output)
+    -> void
+{
+    MC_ASSERT(input.size() >= _blockSize);
+    MC_ASSERT(output.size() >= _blockSize);
+
+    auto const size = _pending.size();
+
+    // Copy the input before the head may overwrite it in-place
+    for (auto& stage : _tail) {
+        auto const pos = _time % stage->blockSize();
+        std::copy(
+            input.begin(),
+            std::next(input.begin(), static_cast<ptrdiff_t>(_blockSize)),
+            std::next(stage->input.begin(), static_cast<ptrdiff_t>(pos))
+        );
+    }
+
+    _head.process(input, output);
+    for (auto i = size_t{0}; i < _blockSize; ++i) {
+        auto& tail = _pending[(_time + i) % size];
+        output[i] += tail;
+        tail = 0.0F;
+    }
+
+    // A stage of block size S starts 2 * S into the filter. The result for the input
+    // block completed S samples ago is due now, it is collected before the next block
+    // is handed to the worker.
+    _time += _blockSize;
+    for (auto& stage : _tail) {
+        if (_time % stage->blockSize() != 0) { continue; }
+        if (stage->posted) {
+            stage->wait();
+            for (auto i = size_t{0}; i < stage->blockSize(); ++i) {
+                _pending[(_time + i) % size] += stage->jobOutput[i];
+            }
+        }
+        stage->post();
+    }
+}
+
+}  // namespace mc
@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/convolution/uniform_partitioned_convolver.hpp>
+
+#include <mc/core/memory.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+/// Streaming convolution with long filters at a small block size. The head of the filter
+/// is convolved by a UniformPartitionedConvolver with blockSize. The tail is split into
+/// stages whose block size grows by 4 per stage, each stage convolves on its own
+/// background thread. A stage with block size S starts 2 * S into the filter, so its
+/// result is only due S samples after its input block is complete. process only waits
+/// for a stage if the worker didn't finish within that time.
+///
+/// The output has the latency of the head, i.e. only the buffering of one block. All
+/// buffers & threads are created by the constructor, process doesn't allocate.
+struct NonUniformPartitionedConvolver
+{
+    NonUniformPartitionedConvolver(Span<float const> filter, size_t blockSize);
+    ~NonUniformPartitionedConvolver();
+
+    NonUniformPartitionedConvolver(NonUniformPartitionedConvolver&& other) noexcept;
+    auto operator=(NonUniformPartitionedConvolver&& other) noexcept
+        -> NonUniformPartitionedConvolver&;
+
+    [[nodiscard]] auto blockSize() const noexcept -> size_t;
+    [[nodiscard]] auto filterSize() const noexcept -> size_t;
+
+    /// Number of stages including the head, stage 0.
+    [[nodiscard]] auto stages() const noexcept -> size_t;
+    [[nodiscard]] auto stageBlockSize(size_t stage) const -> size_t;
+
+    /// Convolves the next blockSize() input samples into blockSize() output samples.
+    /// input & output may be the same span.
+    auto process(Span<float const> input, Span<float> output) -> void;
+
+    /// Waits for all background work & clears all state, the next block starts a new
+    /// stream.
+    auto reset() -> void;
+
+private:
+    struct Stage;
+
+    size_t _blockSize;
+    size_t _filterSize;
+    UniformPartitionedConvolver _head;
+    Vector<UniquePtr<Stage>> _tail;
+
+    // Stage results ahead of the output, indexed by sample time modulo its size
+    Vector<float> _pending;
+    size_t _time{0};
+};
+
+}  // namespace mc
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft/convolution.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/tuple.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+namespace {
+
+// Decaying like an impulse response, so the output stays in a range where float
+// rounding of the direct convolution is small.
+auto makeFilter(size_t size) -> Vector<float>
+{
+    auto filter = generateRandomTestData(size);
+    for (auto i = size_t{0}; i < size; ++i) {
+        filter[i] *= std::exp(-static_cast<float>(i) / 2000.0F);
+    }
+    return filter;
+}
+
+auto processBlocks(NonUniformPartitionedConvolver& convolver, Span<float const> signal)
+    -> Vector<float>
+{
+    auto const blockSize = convolver.blockSize();
+    auto output          = Vector<float>(signal.begin(), signal.end());
+    for (auto i = size_t{0}; i + blockSize <= output.size(); i += blockSize) {
+        auto const block = Span<float>{output}.subspan(i, blockSize);
+        convolver.process(block, block);
+    }
+    return output;
+}
+
+}  // namespace
+
+TEST_CASE("fft/convolution: NonUniformPartitionedConvolver", "[fft][convolution]")
+{
+    auto const [filterSize, blockSize, stages] = GENERATE(
+        std::tuple{size_t{100}, size_t{64}, size_t{1}},
+        std::tuple{size_t{512}, size_t{64}, size_t{1}},
+        std::tuple{size_t{513}, size_t{64}, size_t{2}},
+        std::tuple{size_t{5000}, size_t{64}, size_t{3}},
+        std::tuple{size_t{9000}, size_t{48}, size_t{4}}
+    );
+
+    auto const filter = makeFilter(filterSize);
+    auto const signal = generateRandomTestData(16384);
+
+    auto convolver = NonUniformPartitionedConvolver{filter, blockSize};
+    REQUIRE(convolver.blockSize() == blockSize);
+    REQUIRE(convolver.filterSize() == filterSize);
+    REQUIRE(convolver.stages() == stages);
+    for (auto s = size_t{1}; s < stages; ++s) {
+        REQUIRE(convolver.stageBlockSize(s) == 4 * convolver.stageBlockSize(s - 1));
+    }
+
+    auto expected = Vector<float>(signal.size() + filterSize - 1);
+    convolute<float>(signal, filter, data(expected));
+    expected.resize(signal.size() / blockSize * blockSize);
+
+    auto const isClose = [](auto l, auto r) { return std::abs(l - r) < 1e-3F; };
+    auto output        = processBlocks(convolver, signal);
+    output.resize(expected.size());
+    REQUIRE(ranges::equal(output, expected, isClose));
+
+    convolver.reset();
+    output = processBlocks(convolver, signal);
+    output.resize(expected.size());
+    REQUIRE(ranges::equal(output, expected, isClose));
+}
+
+TEST_CASE("fft/convolution: NonUniformPartitionedConvolver invalid", "[fft][convolution]")
+{
+    auto const filter = Vector<float>(16, 1.0F);
+    auto const empty  = Span<float const>{};
+    REQUIRE_THROWS_AS(NonUniformPartitionedConvolver(filter, 0), InvalidArgument);
+    REQUIRE_THROWS_AS(NonUniformPartitionedConvolver(empty, 64), InvalidArgument);
+}
@@ -10,6 +10,10 @@
 #include <mc/core/cassert.hpp>
 #include <mc/core/climits.hpp>
 #include <mc/core/cstring.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/iterator.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/utility.hpp>
 
 namespace mc {
 namespace {
@@ -17,6 +21,22 @@ auto pow2Ceil(size_t x)
 {
     return static_cast<size_t>(std::pow(2, std::ceil(std::log2(x))));
 }
+
+auto planR2C(FloatSignal& fs, ComplexSignal& cs) -> fftwf_plan
+{
+    auto const lock = std::scoped_lock{fftwPlannerMutex()};
+    auto const n    = static_cast<int>(fs.size());
+    auto* out       = reinterpret_cast<fftwf_complex*>(cs.data());  // NOLINT
+    return fftwf_plan_dft_r2c_1d(n, fs.data(), out, FFTW_ESTIMATE);
+}
+
+auto planC2R(ComplexSignal& cs, FloatSignal& fs) -> fftwf_plan
+{
+    auto const lock = std::scoped_lock{fftwPlannerMutex()};
+    auto const n    = static_cast<int>(fs.size());
+    auto* in        = reinterpret_cast<fftwf_complex*>(cs.data());  // NOLINT
+    return fftwf_plan_dft_c2r_1d(n, in, fs.data(), FFTW_ESTIMATE);
+}
 }  // namespace
 
 FloatSignal::FloatSignal(size_t size) : data_{fftwf_alloc_real(size)}, size_{size}
@@ -35,6 +55,11 @@ FloatSignal::FloatSignal(float* data, size_t size, size_t padBef, size_t padAft)
     std::copy(data, data + size, data_ + padBef);
 }
 
+FloatSignal::FloatSignal(FloatSignal&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)}
+    , size_{std::exchange(other.size_, 0)}
+{}
+
 FloatSignal::~FloatSignal() { fftwf_free(data_); }
 
 ComplexSignal::ComplexSignal(size_t size)
@@ -47,150 +72,209 @@ ComplexSignal::ComplexSignal(size_t size)
 ComplexSignal::~ComplexSignal() { fftwf_free(data_); }
 
 FftForwardPlan::FftForwardPlan(FloatSignal& fs, ComplexSignal& cs)
-    : FftPlan(fftwf_plan_dft_r2c_1d(
-        static_cast<int>(fs.size()),
-        fs.data(),
-        reinterpret_cast<fftwf_complex*>(cs.data()),
-        FFTW_ESTIMATE
-    ))
+    : FftPlan(planR2C(fs, cs))
 {
     MC_ASSERT(cs.size() == (fs.size() / 2U + 1U));
 }
 
+auto FftForwardPlan::execute(FloatSignal& fs, ComplexSignal& cs) -> void
+{
+    auto* out = reinterpret_cast<fftwf_complex*>(cs.data());  // NOLINT
+    fftwf_execute_dft_r2c(get(), fs.data(), out);
+}
+
 FftBackwardPlan::FftBackwardPlan(ComplexSignal& cs, FloatSignal& fs)
-    : FftPlan(fftwf_plan_dft_c2r_1d(
-        static_cast<int>(fs.size()),
-        reinterpret_cast<fftwf_complex*>(cs.data()),
-        fs.data(),
-        FFTW_ESTIMATE
-    ))
+    : FftPlan(planC2R(cs, fs))
 {
     MC_ASSERT(cs.size() == (fs.size() / 2U + 1U));
 }
 
-OverlapSaveConvolver::OverlapSaveConvolver(FloatSignal& signal, FloatSignal& patch)
-    : _signalSize{signal.size()}
+auto FftBackwardPlan::execute(ComplexSignal& cs, FloatSignal& fs) -> void
+{
+    auto* in = reinterpret_cast<fftwf_complex*>(cs.data());  // NOLINT
+    fftwf_execute_dft_c2r(get(), in, fs.data());
+}
+
+// The inverse transform writes back into the real buffer
+struct OverlapSaveConvolver::Worker
+{
+    Worker(size_t chunkSize, size_t chunkSizeComplex)
+        : chunk{chunkSize}
+        , chunkComplex{chunkSizeComplex}
+    {}
+
+    FloatSignal chunk;
+    ComplexSignal chunkComplex;
+};
+
+OverlapSaveConvolver::OverlapSaveConvolver(
+    FloatSignal& signal,
+    FloatSignal& patch,
+    size_t threads
+)
+    : _signal{signal}
     , _patchSize{patch.size()}
-    , _resultSize{_signalSize + _patchSize - 1}
+    , _resultSize{_signal.size() + _patchSize - 1}
     , _paddedPatch{patch.data(), _patchSize, 0, 2 * pow2Ceil(_patchSize) - _patchSize}
     , _resultChunksize{_paddedPatch.size()}
     , _resultChunksizeComplex{_resultChunksize / 2 + 1}
     , _result_stride{_resultChunksize - _patchSize + 1}
     , _paddedPatchComplex{_resultChunksizeComplex}
-    , _paddedSignal{
-          signal.data(),
-          _signalSize,
-          _patchSize - 1,
-          _resultChunksize - (_resultSize % _result_stride)}
-{
-    MC_ASSERT(_patchSize <= _signalSize);
-
-    // chunk the signal into strides of same size as padded patch
-    // and make complex counterparts too, as well as the corresponding xcorr signals
-    for (size_t i = 0; i <= _paddedSignal.size() - _resultChunksize; i += _result_stride) {
-        _inputChunks.push_back(makeUnique<FloatSignal>(&_paddedSignal[i], _resultChunksize)
-        );
-        _inputChunksComplex.push_back(makeUnique<ComplexSignal>(_resultChunksizeComplex));
-        _resultChunks.push_back(makeUnique<FloatSignal>(_resultChunksize));
-        _resultChunksComplex.push_back(makeUnique<ComplexSignal>(_resultChunksizeComplex));
+    , _workers{makeWorkers(threads, numChunks(), _resultChunksize)}
+    , _pool{_workers.size()}
+    , _forwardPlan{_workers[0]->chunk, _workers[0]->chunkComplex}
+    , _backwardPlan{_workers[0]->chunkComplex, _workers[0]->chunk}
+{
+    MC_ASSERT(_patchSize <= _signal.size());
+    transformPatch();
+}
+
+OverlapSaveConvolver::~OverlapSaveConvolver() = default;
+
+// A worker without a chunk would only hold on to its scratch buffers
+auto OverlapSaveConvolver::makeWorkers(size_t threads, size_t chunks, size_t chunkSize)
+    -> Vector<UniquePtr<Worker>>
+{
+    if (threads == 0) {
+        raise<InvalidArgument>("overlap-save: threads must be greater than zero");
+    }
+
+    auto const count = std::min(threads, chunks);
+    auto workers     = Vector<UniquePtr<Worker>>{};
+    workers.reserve(count);
+    for (auto i = size_t{0}; i < count; ++i) {
+        workers.push_back(makeUnique<Worker>(chunkSize, chunkSize / 2 + 1));
     }
-    // make one forward plan per signal chunk, and one for the patch
-    // Also backward plans for the xcorr chunks
-    _forwardPlans.emplace_back(new FftForwardPlan(_paddedPatch, _paddedPatchComplex));
-    for (size_t i = 0; i < _inputChunks.size(); i++) {
-        _forwardPlans.emplace_back(
-            new FftForwardPlan(*_inputChunks.at(i), *_inputChunksComplex.at(i))
+    return workers;
+}
+
+auto OverlapSaveConvolver::threads() const noexcept -> size_t { return _workers.size(); }
+
+auto OverlapSaveConvolver::numChunks() const noexcept -> size_t
+{
+    return (_resultSize + _result_stride - 1) / _result_stride;
+}
+
+auto OverlapSaveConvolver::setSignal(Span<float const> signal) -> void
+{
+    if (signal.size() != _signal.size()) {
+        raisef<InvalidArgument>(
+            "overlap-save: signal size must be {}, got {}",
+            _signal.size(),
+            signal.size()
         );
-        _backwardPlans.emplace_back(
-            new FftBackwardPlan(*_resultChunksComplex.at(i), *_resultChunks.at(i))
+    }
+
+    _signal = signal;
+    _state  = State::Uninitialized;
+}
+
+auto OverlapSaveConvolver::setPatch(Span<float const> patch) -> void
+{
+    if (patch.size() != _patchSize) {
+        raisef<InvalidArgument>(
+            "overlap-save: patch size must be {}, got {}",
+            _patchSize,
+            patch.size()
         );
     }
+
+    _state = State::Uninitialized;
+
+    // The padding behind the patch stays zero
+    auto const current = Span<float const>{_paddedPatch.data(), _patchSize};
+    if (ranges::equal(patch, current)) { return; }
+    ranges::copy(patch, _paddedPatch.begin());
+    transformPatch();
 }
 
-auto OverlapSaveConvolver::convolute() -> void
-{
-    execute(false);
-    _state = State::Conv;
-}
-
-auto OverlapSaveConvolver::crossCorrelate() -> void
-{
-    execute(true);
-    _state = State::Xcorr;
-}
-
-// This method implements step 6 of the overlap-save algorithm. In convolution, the first
-// (P-1) samples of each chunk are discarded, in xcorr the last (P-1) ones. Therefore,
-// depending on the current _state_, the corresponding method is used. USAGE: Every time it
-// is called, this function returns a new FloatSignal instance of size
-// len(signal)+len(patch)-1. If the last operation performed was convolute(), this function
-// will return the  convolution of signal and patch. If the last operation performed was
-// crossCorrelate(), the result will contain the cross-correlation. If none of them was
-// performed at the moment of calling this function, an exception will be thrown. The
-// indexing will start with the most negative relation, and increase accordingly. Which
-// means:
-//   given S:=len(signal), P:=len(patch), T:=S+P-1
-// for 0 <= i < T, result[i] will hold dot_product(patch, signal[i-(P-1) : i])
-//   where patch will be "reversed" if the convolution was performed. For example:
-// Signal :=        [1 2 3 4 5 6 7]    Patch = [1 1 1]
-// Result[0] =  [1 1 1]                        => 1*1         = 1  // FIRST ENTRY
-// Result[1] =    [1 1 1]                      => 1*1+1*2     = 3
-// Result[2] =      [1 1 1]                    => 1*1+1*2+1*3 = 8  // FIRST NON-NEG ENTRY AT
-// P-1
-//   ...
-// Result[8] =                  [1 1 1]        => 1*7         = 7  // LAST ENTRY
-// Note that the returned signal object takes care of its own memory, so no management is
-// needed.
+auto OverlapSaveConvolver::convolute(Span<float> output) -> void
+{
+    execute(false, output);
+}
+
+auto OverlapSaveConvolver::crossCorrelate(Span<float> output) -> void
+{
+    execute(true, output);
+}
+
+auto OverlapSaveConvolver::convolute() -> void { _state = State::Conv; }
+
+auto OverlapSaveConvolver::crossCorrelate() -> void { _state = State::Xcorr; }
+
 auto OverlapSaveConvolver::extractResult() -> FloatSignal
 {
     MC_ASSERT(_state != State::Uninitialized);
+    auto result = FloatSignal{_resultSize};
+    execute(_state == State::Xcorr, result);
+    return result;
+}
+
+// The 1/X of the unnormalized inverse transform is folded into the patch spectrum
+auto OverlapSaveConvolver::transformPatch() -> void
+{
+    _forwardPlan.execute(_paddedPatch, _paddedPatchComplex);
+    auto const scale = 1.0F / static_cast<float>(_resultChunksize);
+    for (auto& bin : _paddedPatchComplex) { bin *= scale; }
+}
 
-    auto result     = FloatSignal(_resultSize);
-    auto* resultArr = result.data();
-
-    auto const numChunks = _resultChunks.size();
-    auto const offset
-        = _state == State::Conv ? _resultChunksize - _result_stride : size_t{0};
-    for (auto i = size_t{0}; i < numChunks; i++) {
-        auto* xcArr           = _resultChunks.at(i)->data();
-        auto const chunkBegin = i * _result_stride;
-
-        // if the last chunk goes above resultSize_
-        // reduce copy size. else copy_size=result_stride_
-        auto copySize = _result_stride;
-        copySize -= (chunkBegin + _result_stride > _resultSize)
-                      ? chunkBegin + _result_stride - _resultSize
-                      : 0;
-
-        auto const* first = xcArr + offset;
-        std::copy(first, first + copySize, resultArr + chunkBegin);
+// This private method implements steps 2-6 of the algorithm. If the given flag is false,
+// it will perform a convolution (4a), and a cross-correlation (4b) otherwise.
+// The chunks are independent & write disjoint parts of the output.
+auto OverlapSaveConvolver::execute(bool const crossCorrelate, Span<float> output) -> void
+{
+    if (output.size() < _resultSize) {
+        raisef<InvalidArgument>(
+            "overlap-save: output needs {} samples, got {}",
+            _resultSize,
+            output.size()
+        );
     }
 
-    return result;
+    auto chunks = [this, crossCorrelate, output](auto& w, size_t first, size_t last) {
+        for (auto i = first; i < last; ++i) { executeChunk(*w, i, crossCorrelate, output); }
+    };
+    _pool.run(_workers, numChunks(), chunks);
 }
 
-// This private method implements steps 3,4,5 of the algorithm. If the given flag is false,
-// it will perform a convolution (4a), and a cross-correlation (4b) otherwise.
-// Note the parallelization with OpenMP, which increases performance in supporting CPUs.
-auto OverlapSaveConvolver::execute(bool const crossCorrelate) -> void
+// Chunk i covers [i*L - (P-1), i*L - (P-1) + X) of the signal, zero outside of it. In
+// convolution, its first (P-1) samples are discarded, in xcorr the last (P-1) ones.
+auto OverlapSaveConvolver::executeChunk(
+    Worker& w,
+    size_t chunk,
+    bool crossCorrelate,
+    Span<float> output
+) -> void
 {
-    for (auto& forwardPlan : _forwardPlans) { forwardPlan->execute(); }
+    auto const signalSize = static_cast<ptrdiff_t>(_signal.size());
+    auto const patchPad   = static_cast<ptrdiff_t>(_patchSize - 1);
+    auto const chunkSize  = static_cast<ptrdiff_t>(_resultChunksize);
+    auto const offset     = crossCorrelate ? size_t{0} : _resultChunksize - _result_stride;
 
-    auto operation = (crossCorrelate) ? spectralCorrelation : spectralConvolution;
-    for (size_t i = 0; i < _resultChunks.size(); i++) {
-        operation(
-            *_inputChunksComplex.at(i),
-            this->_paddedPatchComplex,
-            *_resultChunksComplex.at(i)
+    auto const chunkBegin = chunk * _result_stride;
+    auto const first      = static_cast<ptrdiff_t>(chunkBegin) - patchPad;
+    auto const copyFirst  = std::max(first, ptrdiff_t{0});
+    auto const copyLast   = std::min(first + chunkSize, signalSize);
+
+    auto const in = _signal.begin();
+    std::fill(w.chunk.begin(), w.chunk.end(), 0.0F);
+    if (copyFirst < copyLast) {
+        std::copy(
+            std::next(in, copyFirst),
+            std::next(in, copyLast),
+            std::next(w.chunk.begin(), copyFirst - first)
         );
     }
 
-    for (size_t i = 0; i < _resultChunks.size(); i++) {
-        _backwardPlans.at(i)->execute();
-        auto& chunk = *_resultChunks.at(i);
-        ranges::transform(chunk, begin(chunk), [this](auto arg) {
-            return arg / _resultChunksize;
-        });
-    }
+    auto operation = (crossCorrelate) ? spectralCorrelation : spectralConvolution;
+    _forwardPlan.execute(w.chunk, w.chunkComplex);
+    operation(w.chunkComplex, _paddedPatchComplex, w.chunkComplex);
+    _backwardPlan.execute(w.chunkComplex, w.chunk);
+
+    // the last chunk may reach beyond the end of the result
+    auto const copySize = std::min(_result_stride, _resultSize - chunkBegin);
+    auto const* src     = std::next(w.chunk.begin(), static_cast<ptrdiff_t>(offset));
+    auto const* last    = std::next(src, static_cast<ptrdiff_t>(copySize));
+    std::copy(src, last, std::next(output.begin(), static_cast<ptrdiff_t>(chunkBegin)));
 }
 }  // namespace mc
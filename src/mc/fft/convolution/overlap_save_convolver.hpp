@@ -4,6 +4,9 @@
 
 #include <mc/core/config.hpp>
 
+#include <mc/fft/transform/backend/fftw.hpp>
+#include <mc/fft/transform/thread_pool.hpp>
+
 #include <mc/core/algorithm.hpp>
 #include <mc/core/array.hpp>
 #include <mc/core/cmath.hpp>
@@ -30,6 +33,12 @@ struct FloatSignal
     FloatSignal(float* data, size_t size, size_t padBef, size_t padAft);
     ~FloatSignal();
 
+    FloatSignal(FloatSignal const& other)                    = delete;
+    auto operator=(FloatSignal const& other) -> FloatSignal& = delete;
+
+    /// Takes over the array, other is left empty.
+    FloatSignal(FloatSignal&& other) noexcept;
+
     [[nodiscard]] auto begin() -> float* { return data_; }
 
     [[nodiscard]] auto begin() const -> float const* { return data_; }
@@ -72,6 +81,9 @@ struct ComplexSignal
     explicit ComplexSignal(size_t size);
     ~ComplexSignal();
 
+    ComplexSignal(ComplexSignal const& other)                    = delete;
+    auto operator=(ComplexSignal const& other) -> ComplexSignal& = delete;
+
     [[nodiscard]] auto begin() -> Complex<float>* { return data_; }
 
     [[nodiscard]] auto begin() const -> Complex<float> const* { return data_; }
@@ -116,10 +128,17 @@ struct FftPlan
 {
     explicit FftPlan(fftwf_plan p) : _plan(p) {}
 
-    ~FftPlan() { fftwf_destroy_plan(_plan); }
+    ~FftPlan()
+    {
+        auto const lock = std::scoped_lock{fftwPlannerMutex()};
+        fftwf_destroy_plan(_plan);
+    }
 
     auto execute() { fftwf_execute(_plan); }
 
+protected:
+    [[nodiscard]] auto get() const noexcept -> fftwf_plan { return _plan; }
+
 private:
     fftwf_plan _plan;
 };
@@ -134,6 +153,11 @@ struct FftForwardPlan : FftPlan
     // doesn't hold. Since the signals and the superclass already have proper destructors,
     // no special memory management has to be done.
     explicit FftForwardPlan(FloatSignal& fs, ComplexSignal& cs);
+
+    using FftPlan::execute;
+
+    /// Runs the plan on other arrays of the same size & alignment as the planned ones.
+    auto execute(FloatSignal& fs, ComplexSignal& cs) -> void;
 };
 
 // This backward plan (1D, C->R) is adequate to process spectra of 1D floats (real).
@@ -145,6 +169,12 @@ struct FftBackwardPlan : FftPlan
     // runtime error if this condition doesn't hold. Since the signals and the superclass
     // already have proper destructors, no special memory management has to be done.
     explicit FftBackwardPlan(ComplexSignal& cs, FloatSignal& fs);
+
+    using FftPlan::execute;
+
+    /// Runs the plan on other arrays of the same size & alignment as the planned ones.
+    /// Like every complex->real transform, this overwrites the input.
+    auto execute(ComplexSignal& cs, FloatSignal& fs) -> void;
 };
 
 /// This class performs an efficient version of the spectral convolution/cross-correlation
@@ -164,18 +194,43 @@ struct FftBackwardPlan : FftPlan
 ///      multiplication
 ///   5. Compute the inverse FFT of every result of step 4
 ///   6. Concatenate the resulting chunks, ignoring (P-1) samples per chunk
-/// Note that steps 3,4,5 may be parallelized with some significant gain in performance.
+/// Steps 2-6 run chunk by chunk through a single pair of plans, every chunk is written
+/// straight into the caller's output. The chunks are split across threads, which are
+/// started once by the constructor, each worker owns one scratch chunk. Setup cost &
+/// working memory only depend on the patch length & the number of threads, not on the
+/// signal length.
+/// The result doesn't depend on the number of threads, every chunk is computed the exact
+/// same way.
 /// In this class: X = result_chunksize, L = result_stride
 struct OverlapSaveConvolver
 {
-    /// The only constructor for the class, receives two signals and performs steps 1 and 2
-    /// of the algorithm on them. The signals are passed by reference but the class works
-    /// with padded copies of them, so no care has to be taken regarding memory management.
-    /// The wisdomPath may be empty, or a path to a valid wisdom file.
+    /// The only constructor for the class, receives two signals and performs step 1 of
+    /// the algorithm. The patch is copied, the signal is only referenced and read by
+    /// convolute & crossCorrelate, so it has to outlive the convolver.
     /// Note that len(signal) can never be smaller than len(patch), or an exception is
     /// thrown.
-    OverlapSaveConvolver(FloatSignal& signal, FloatSignal& patch);
+    OverlapSaveConvolver(FloatSignal& signal, FloatSignal& patch, size_t threads = 1);
+    ~OverlapSaveConvolver();
+
+    /// Number of workers, the requested threads capped at the number of chunks.
+    [[nodiscard]] auto threads() const noexcept -> size_t;
+
+    /// Replaces the signal by one of the same length, which is referenced like the one
+    /// passed to the constructor. Plans & buffers are reused, nothing is allocated.
+    auto setSignal(Span<float const> signal) -> void;
+
+    /// Replaces the patch by one of the same length. The patch spectrum is only computed
+    /// again if the samples differ from the current patch. Doesn't allocate.
+    auto setPatch(Span<float const> patch) -> void;
 
+    /// Steps 2-6 for all chunks, each chunk is written straight into output, which needs
+    /// len(signal)+len(patch)-1 samples, see extractResult for the layout. Don't
+    /// allocate, for any number of threads, the chunks run on the workers & threads
+    /// created by the constructor.
+    auto convolute(Span<float> output) -> void;
+    auto crossCorrelate(Span<float> output) -> void;
+
+    /// Only select the operation, it runs when extractResult() is called.
     auto convolute() -> void;
     auto crossCorrelate() -> void;
 
@@ -200,41 +255,43 @@ struct OverlapSaveConvolver
     //   ...
     // Result[8] =                  [1 1 1]        => 1*7         = 7  // LAST ENTRY
     // Note that the returned signal object takes care of its own memory, so no management
-    // is needed.
+    // is needed. The chunks are computed into the new signal by this call, use the
+    // overloads taking an output to reuse memory.
     auto extractResult() -> FloatSignal;
 
 private:
-    // This private method implements steps 3,4,5 of the algorithm. If the given flag is
+    struct Worker;
+
+    [[nodiscard]] static auto makeWorkers(size_t threads, size_t chunks, size_t chunkSize)
+        -> Vector<UniquePtr<Worker>>;
+    [[nodiscard]] auto numChunks() const noexcept -> size_t;
+
+    // This private method implements steps 2-6 of the algorithm. If the given flag is
     // false, it will perform a convolution (4a), and a cross-correlation (4b) otherwise.
-    // Note the parallelization with OpenMP, which increases performance in supporting CPUs.
-    auto execute(bool crossCorrelate) -> void;
+    auto execute(bool crossCorrelate, Span<float> output) -> void;
+    auto transformPatch() -> void;
+    auto executeChunk(Worker& w, size_t chunk, bool crossCorrelate, Span<float> output)
+        -> void;
 
     // grab input lengths
-    size_t _signalSize;
+    Span<float const> _signal;
     size_t _patchSize;
     size_t _resultSize;
 
-    // make padded copies of the inputs and get chunk measurements
+    // make a padded copy of the patch and get chunk measurements
     FloatSignal _paddedPatch;
     size_t _resultChunksize;
     size_t _resultChunksizeComplex;
     size_t _result_stride;
     ComplexSignal _paddedPatchComplex;
 
-    // padded copy of the signal
-    FloatSignal _paddedSignal;
-
-    // the deconstructed signal
-    Vector<UniquePtr<FloatSignal>> _inputChunks;
-    Vector<UniquePtr<ComplexSignal>> _inputChunksComplex;
-
-    // the corresponding chunks holding convs/xcorrs
-    Vector<UniquePtr<FloatSignal>> _resultChunks;
-    Vector<UniquePtr<ComplexSignal>> _resultChunksComplex;
+    // one scratch chunk per thread, the pool runs one thread per worker
+    Vector<UniquePtr<Worker>> _workers;
+    ThreadPool _pool;
 
-    // the corresponding plans (plus the plan of the patch)
-    Vector<UniquePtr<FftForwardPlan>> _forwardPlans;
-    Vector<UniquePtr<FftBackwardPlan>> _backwardPlans;
+    // one plan pair, executed on the patch & on every chunk
+    FftForwardPlan _forwardPlan;
+    FftBackwardPlan _backwardPlan;
 
     // Basic state management to prevent getters from being called prematurely.
     // Also to adapt the extractResult getter, since Conv and Xcorr padding behaves
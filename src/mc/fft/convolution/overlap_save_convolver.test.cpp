@@ -2,6 +2,14 @@
 
 #include <mc/fft/convolution.hpp>
 
+#include <mc/core/algorithm.hpp>
+#include <mc/core/atomic.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/cstdlib.hpp>
+#include <mc/core/new.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/utility.hpp>
+#include <mc/core/vector.hpp>
 #include <mc/testing/test.hpp>
 
 #include <catch2/catch_test_macros.hpp>
@@ -9,6 +17,22 @@
 
 using namespace mc;
 
+namespace {
+// Counts the allocations of the whole test binary, including the pool threads
+auto allocations = std::atomic<size_t>{0};
+}  // namespace
+
+auto operator new(std::size_t size) -> void*
+{
+    ++allocations;
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) { return ptr; }
+    throw std::bad_alloc{};
+}
+
+auto operator delete(void* ptr) noexcept -> void { std::free(ptr); }
+
+auto operator delete(void* ptr, std::size_t /*size*/) noexcept -> void { std::free(ptr); }
+
 TEST_CASE("fft/convolution: OverlapSaveConvolver", "[fft][convolution]")
 {
 
@@ -32,3 +56,165 @@ TEST_CASE("fft/convolution: OverlapSaveConvolver", "[fft][convolution]")
     x.crossCorrelate();
     CHECK(approxEqual<float>(x.extractResult(), testData[3]));
 }
+
+TEST_CASE("fft/convolution: OverlapSaveConvolver many chunks", "[fft][convolution]")
+{
+    auto const [signalSize, patchSize] = GENERATE(
+        std::pair{size_t{1000}, size_t{3}},
+        std::pair{size_t{5000}, size_t{129}},
+        std::pair{size_t{64}, size_t{64}}
+    );
+
+    auto signalData = Vector<float>(signalSize);
+    auto patchData  = Vector<float>(patchSize);
+    for (auto i = size_t{0}; i < signalSize; ++i) {
+        signalData[i] = static_cast<float>(i % 17) / 17.0F - 0.5F;
+    }
+    for (auto i = size_t{0}; i < patchSize; ++i) {
+        patchData[i] = static_cast<float>(i % 5) / 5.0F;
+    }
+
+    auto s = FloatSignal{signalData.data(), signalData.size()};
+    auto p = FloatSignal{patchData.data(), patchData.size()};
+    auto x = OverlapSaveConvolver{s, p};
+
+    // result[i] = sum_k signal[i - (P-1) + k] * patch[k]
+    auto expected = Vector<float>(signalSize + patchSize - 1);
+    for (auto i = size_t{0}; i < expected.size(); ++i) {
+        auto sum = 0.0;
+        for (auto k = size_t{0}; k < patchSize; ++k) {
+            auto const j = i + k;
+            if (j < patchSize - 1 || j - (patchSize - 1) >= signalSize) { continue; }
+            sum += static_cast<double>(signalData[j - (patchSize - 1)] * patchData[k]);
+        }
+        expected[i] = static_cast<float>(sum);
+    }
+
+    auto const near = [](float a, float b) { return std::abs(a - b) < 1e-3F; };
+
+    x.crossCorrelate();
+    auto const result = x.extractResult();
+    REQUIRE(result.size() == expected.size());
+    CHECK(ranges::equal(result, expected, near));
+}
+
+TEST_CASE("fft/convolution: OverlapSaveConvolver threads", "[fft][convolution]")
+{
+    auto signalData = Vector<float>(20000);
+    auto patchData  = Vector<float>(300);
+    for (auto i = size_t{0}; i < signalData.size(); ++i) {
+        signalData[i] = std::sin(static_cast<float>(i) * 0.01F);
+    }
+    for (auto i = size_t{0}; i < patchData.size(); ++i) {
+        patchData[i] = static_cast<float>(i % 7) / 7.0F;
+    }
+
+    auto s = FloatSignal{signalData.data(), signalData.size()};
+    auto p = FloatSignal{patchData.data(), patchData.size()};
+
+    auto serial = OverlapSaveConvolver{s, p};
+    REQUIRE(serial.threads() == 1U);
+    serial.crossCorrelate();
+    auto const expected = serial.extractResult();
+
+    // 20299 samples in chunks of 1024 - 299, the workers are capped at the 28 chunks
+    auto const threads = GENERATE(size_t{2}, size_t{3}, size_t{64});
+    auto parallel      = OverlapSaveConvolver{s, p, threads};
+    REQUIRE(parallel.threads() == std::min(threads, size_t{28}));
+    parallel.crossCorrelate();
+    auto const result = parallel.extractResult();
+
+    // Every chunk is computed the same way, independent of the thread it runs on
+    CHECK(ranges::equal(result, expected));
+
+    REQUIRE_THROWS_AS(OverlapSaveConvolver(s, p, 0), InvalidArgument);
+}
+
+TEST_CASE("fft/convolution: OverlapSaveConvolver rebind", "[fft][convolution]")
+{
+    auto makeData = [](size_t size, float step) {
+        auto data = Vector<float>(size);
+        for (auto i = size_t{0}; i < size; ++i) {
+            data[i] = std::sin(static_cast<float>(i) * step);
+        }
+        return data;
+    };
+
+    auto signalA = makeData(3000, 0.01F);
+    auto signalB = makeData(3000, 0.03F);
+    auto patchA  = makeData(100, 0.2F);
+    auto patchB  = makeData(100, 0.5F);
+
+    auto const threads = GENERATE(size_t{1}, size_t{2});
+
+    auto s = FloatSignal{signalA.data(), signalA.size()};
+    auto p = FloatSignal{patchA.data(), patchA.size()};
+    auto x = OverlapSaveConvolver{s, p, threads};
+
+    auto output = Vector<float>(signalA.size() + patchA.size() - 1);
+
+    auto const check = [&](Vector<float>& signal, Vector<float>& patch) {
+        auto fs        = FloatSignal{signal.data(), signal.size()};
+        auto fp        = FloatSignal{patch.data(), patch.size()};
+        auto reference = OverlapSaveConvolver{fs, fp, 2};
+
+        x.convolute(output);
+        reference.convolute();
+        CHECK(ranges::equal(output, reference.extractResult()));
+
+        x.crossCorrelate(output);
+        reference.crossCorrelate();
+        CHECK(ranges::equal(output, reference.extractResult()));
+    };
+
+    check(signalA, patchA);
+
+    x.setSignal(signalB);
+    check(signalB, patchA);
+
+    x.setPatch(patchB);
+    check(signalB, patchB);
+
+    x.setPatch(patchB);
+    x.setSignal(signalA);
+    check(signalA, patchB);
+
+    REQUIRE_THROWS_AS(x.setSignal(Span<float const>{signalA}.first(10)), InvalidArgument);
+    REQUIRE_THROWS_AS(x.setPatch(Span<float const>{patchA}.first(10)), InvalidArgument);
+}
+
+TEST_CASE("fft/convolution: OverlapSaveConvolver no allocation", "[fft][convolution]")
+{
+    auto signalA = Vector<float>(3000, 1.0F);
+    auto signalB = Vector<float>(3000, 2.0F);
+    auto patchA  = Vector<float>(100, 0.5F);
+    auto patchB  = Vector<float>(100, 0.25F);
+    auto output  = Vector<float>(signalA.size() + patchA.size() - 1);
+
+    auto const threads = GENERATE(size_t{1}, size_t{2}, size_t{4});
+
+    auto s = FloatSignal{signalA.data(), signalA.size()};
+    auto p = FloatSignal{patchA.data(), patchA.size()};
+    auto x = OverlapSaveConvolver{s, p, threads};
+
+    // Measure the steady state, after every thread ran through the FFT library once
+    x.convolute(output);
+
+    auto const before = allocations.load();
+    x.setSignal(signalB);
+    x.setPatch(patchB);
+    x.convolute(output);
+    x.crossCorrelate(output);
+    auto const after = allocations.load();
+
+    REQUIRE(after == before);
+
+    // The chunks land in the caller's output, which has to hold the whole result
+    auto sB        = FloatSignal{signalB.data(), signalB.size()};
+    auto pB        = FloatSignal{patchB.data(), patchB.size()};
+    auto reference = OverlapSaveConvolver{sB, pB};
+    reference.crossCorrelate();
+    REQUIRE(ranges::equal(output, reference.extractResult()));
+    auto shorter = Span<float>{output}.first(output.size() - 1);
+    REQUIRE_THROWS_AS(x.convolute(shorter), InvalidArgument);
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "uniform_partitioned_convolver.hpp"
+
+#include <mc/fft/algorithm/spectral_convolution.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/iterator.hpp>
+#include <mc/core/stdexcept.hpp>
+
+namespace mc {
+
+namespace {
+
+auto checkBlockSize(Span<float const> filter, size_t blockSize) -> size_t
+{
+    if (filter.empty()) { raise<InvalidArgument>("partitioned convolver: empty filter"); }
+    if (blockSize == 0) {
+        raise<InvalidArgument>("partitioned convolver: block size must not be zero");
+    }
+    return blockSize;
+}
+
+}  // namespace
+
+UniformPartitionedConvolver::UniformPartitionedConvolver(
+    Span<float const> filter,
+    size_t blockSize
+)
+    : _blockSize{checkBlockSize(filter, blockSize)}
+    , _filterSize{filter.size()}
+    , _partitions{(filter.size() + blockSize - 1) / blockSize}
+    , _engine{makeRFFT(2 * blockSize)}
+    , _filter(_partitions * blockSize)
+    , _delayLine(_partitions * blockSize)
+    , _input(2 * blockSize)
+    , _sum(blockSize)
+    , _output(2 * blockSize)
+{
+    // Each partition is zero padded to the transform size, the scratch is reused
+    auto const scale = 1.0F / static_cast<float>(2 * blockSize);
+    for (auto p = size_t{0}; p < _partitions; ++p) {
+        auto const part = filter.subspan(p * blockSize);
+        auto const size = std::min(part.size(), blockSize);
+        ranges::fill(_input, 0.0F);
+        for (auto i = size_t{0}; i < size; ++i) { _input[i] = part[i] * scale; }
+        rfftPacked(_engine, _input, spectrum(_filter, p));
+    }
+
+    reset();
+}
+
+auto UniformPartitionedConvolver::blockSize() const noexcept -> size_t
+{
+    return _blockSize;
+}
+
+auto UniformPartitionedConvolver::filterSize() const noexcept -> size_t
+{
+    return _filterSize;
+}
+
+auto UniformPartitionedConvolver::partitions() const noexcept -> size_t
+{
+    return _partitions;
+}
+
+auto UniformPartitionedConvolver::reset() -> void
+{
+    ranges::fill(_delayLine, Complex<float>{});
+    ranges::fill(_input, 0.0F);
+    _delayPos = 0;
+}
+
+auto UniformPartitionedConvolver::process(Span<float const> input, Span<float> output)
+    -> void
+{
+    MC_ASSERT(input.size() >= _blockSize);
+    MC_ASSERT(output.size() >= _blockSize);
+
+    auto const b    = static_cast<ptrdiff_t>(_blockSize);
+    auto const half = std::next(_input.begin(), b);
+    std::copy(half, _input.end(), _input.begin());
+    std::copy(input.begin(), std::next(input.begin(), b), half);
+
+    rfftPacked(_engine, _input, spectrum(_delayLine, _delayPos));
+
+    // Partition p is applied to the input block of p blocks ago
+    ranges::fill(_sum, Complex<float>{});
+    for (auto p = size_t{0}; p < _partitions; ++p) {
+        auto const slot = (_delayPos + _partitions - p) % _partitions;
+        spectralConvolutionPackedAccumulate(
+            spectrum(_delayLine, slot),
+            spectrum(_filter, p),
+            _sum
+        );
+    }
+    _delayPos = (_delayPos + 1) % _partitions;
+
+    // The first half is circular aliasing, the second half the linear convolution
+    irfftPacked(_engine, _sum, _output);
+    std::copy(std::next(_output.begin(), b), _output.end(), output.begin());
+}
+
+auto UniformPartitionedConvolver::spectrum(AlignedVector<Complex<float>>& v, size_t i)
+    -> Span<Complex<float>>
+{
+    return Span<Complex<float>>{v}.subspan(i * _blockSize, _blockSize);
+}
+
+}  // namespace mc
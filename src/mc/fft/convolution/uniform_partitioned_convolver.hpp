@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/transform/aligned_allocator.hpp>
+#include <mc/fft/transform/rfft.hpp>
+
+#include <mc/core/complex.hpp>
+#include <mc/core/span.hpp>
+
+namespace mc {
+
+/// Streaming convolution with a fixed filter, for signals processed in blocks of
+/// blockSize samples. The filter is split into blockSize long partitions, each is
+/// convolved by overlap-save on transforms of 2 * blockSize. Spectra of past input blocks
+/// are kept in a frequency-domain delay line, so every block costs one forward & one
+/// inverse transform plus one spectral product per partition.
+///
+/// Each output block holds the convolution up to the last sample of the input block, the
+/// only latency is the buffering of one block. All buffers are allocated by the
+/// constructor, process doesn't allocate.
+struct UniformPartitionedConvolver
+{
+    UniformPartitionedConvolver(Span<float const> filter, size_t blockSize);
+
+    [[nodiscard]] auto blockSize() const noexcept -> size_t;
+    [[nodiscard]] auto filterSize() const noexcept -> size_t;
+    [[nodiscard]] auto partitions() const noexcept -> size_t;
+
+    /// Convolves the next blockSize() input samples into blockSize() output samples.
+    /// input & output may be the same span.
+    auto process(Span<float const> input, Span<float> output) -> void;
+
+    /// Clears the delay line, the next block starts a new stream.
+    auto reset() -> void;
+
+private:
+    [[nodiscard]] auto spectrum(AlignedVector<Complex<float>>& v, size_t i)
+        -> Span<Complex<float>>;
+
+    size_t _blockSize;
+    size_t _filterSize;
+    size_t _partitions;
+    RFFT<float> _engine;
+
+    // Packed spectra of blockSize bins, partition by partition. The filter spectra
+    // include the 1/N of the inverse transform.
+    AlignedVector<Complex<float>> _filter;
+    AlignedVector<Complex<float>> _delayLine;
+    size_t _delayPos{0};
+
+    // The previous & the current input block
+    AlignedVector<float> _input;
+    AlignedVector<Complex<float>> _sum;
+    AlignedVector<float> _output;
+};
+
+}  // namespace mc
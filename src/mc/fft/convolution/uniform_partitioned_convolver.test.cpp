@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft/convolution.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/tuple.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+namespace {
+
+auto processBlocks(UniformPartitionedConvolver& convolver, Span<float const> signal)
+    -> Vector<float>
+{
+    auto const blockSize = convolver.blockSize();
+    auto output          = Vector<float>(signal.begin(), signal.end());
+    for (auto i = size_t{0}; i + blockSize <= output.size(); i += blockSize) {
+        auto const block = Span<float>{output}.subspan(i, blockSize);
+        convolver.process(block, block);
+    }
+    return output;
+}
+
+}  // namespace
+
+TEST_CASE("fft/convolution: UniformPartitionedConvolver", "[fft][convolution]")
+{
+    auto const [filterSize, blockSize] = GENERATE(
+        std::tuple{size_t{1}, size_t{64}},
+        std::tuple{size_t{63}, size_t{64}},
+        std::tuple{size_t{64}, size_t{64}},
+        std::tuple{size_t{1000}, size_t{128}},
+        std::tuple{size_t{300}, size_t{100}},
+        std::tuple{size_t{2048}, size_t{512}}
+    );
+
+    auto const filter = generateRandomTestData(filterSize);
+    auto const signal = generateRandomTestData(blockSize * 12);
+
+    auto convolver = UniformPartitionedConvolver{filter, blockSize};
+    REQUIRE(convolver.blockSize() == blockSize);
+    REQUIRE(convolver.filterSize() == filterSize);
+    REQUIRE(convolver.partitions() == (filterSize + blockSize - 1) / blockSize);
+
+    auto expected = Vector<float>(signal.size() + filterSize - 1);
+    convolute<float>(signal, filter, data(expected));
+    expected.resize(signal.size());
+
+    auto const isClose = [](auto l, auto r) { return std::abs(l - r) < 1e-3F; };
+    auto const output  = processBlocks(convolver, signal);
+    REQUIRE(ranges::equal(output, expected, isClose));
+
+    // A new stream after reset doesn't see the previous one
+    convolver.reset();
+    REQUIRE(ranges::equal(processBlocks(convolver, signal), expected, isClose));
+}
+
+TEST_CASE("fft/convolution: UniformPartitionedConvolver invalid", "[fft][convolution]")
+{
+    auto const filter = Vector<float>(16, 1.0F);
+    auto const empty  = Span<float const>{};
+    REQUIRE_THROWS_AS(UniformPartitionedConvolver(filter, 0), InvalidArgument);
+    REQUIRE_THROWS_AS(UniformPartitionedConvolver(empty, 64), InvalidArgument);
+}
@@ -2,5 +2,15 @@
 
 #pragma once
 
+#include <mc/fft/transform/aligned_allocator.hpp>
+#include <mc/fft/transform/backend/fftw.hpp>
+#include <mc/fft/transform/batch.hpp>
+#include <mc/fft/transform/batch_fft.hpp>
+#include <mc/fft/transform/dct.hpp>
 #include <mc/fft/transform/fft.hpp>
+#include <mc/fft/transform/plan_cache.hpp>
 #include <mc/fft/transform/rfft.hpp>
+#include <mc/fft/transform/rfft2d.hpp>
+#include <mc/fft/transform/simd.hpp>
+#include <mc/fft/transform/small_box.hpp>
+#include <mc/fft/transform/stft.hpp>
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/core/cstddef.hpp>
+#include <mc/core/cstdint.hpp>
+#include <mc/core/limits.hpp>
+#include <mc/core/new.hpp>
+#include <mc/core/vector.hpp>
+
+#include <pffft.h>
+
+namespace mc {
+
+/// Alignment in bytes pffft's SIMD path needs for input, output & work buffers.
+[[nodiscard]] inline auto simdAlignment() noexcept -> size_t
+{
+    return static_cast<size_t>(pffft_simd_size()) * sizeof(float);
+}
+
+[[nodiscard]] inline auto isSimdAligned(void const* ptr) noexcept -> bool
+{
+    return reinterpret_cast<uintptr_t>(ptr) % simdAlignment() == 0;  // NOLINT
+}
+
+/// Allocator on top of pffft_aligned_malloc, the memory satisfies simdAlignment() for
+/// every SIMD width pffft supports.
+template<typename T>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(AlignedAllocator<U> const& /*other*/) noexcept
+    {}
+
+    [[nodiscard]] auto allocate(size_t n) -> T*
+    {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length{};
+        }
+
+        auto* ptr = pffft_aligned_malloc(n * sizeof(T));
+        if (ptr == nullptr) { throw std::bad_alloc{}; }
+        return static_cast<T*>(ptr);
+    }
+
+    auto deallocate(T* ptr, size_t /*n*/) noexcept -> void { pffft_aligned_free(ptr); }
+};
+
+template<typename T, typename U>
+[[nodiscard]] auto
+operator==(AlignedAllocator<T> const& /*lhs*/, AlignedAllocator<U> const& /*rhs*/) noexcept
+    -> bool
+{
+    return true;
+}
+
+template<typename T, typename U>
+[[nodiscard]] auto
+operator!=(AlignedAllocator<T> const& /*lhs*/, AlignedAllocator<U> const& /*rhs*/) noexcept
+    -> bool
+{
+    return false;
+}
+
+/// Buffer which can be handed to the pffft engines without violating their alignment
+/// requirements.
+template<typename T>
+using AlignedVector = Vector<T, AlignedAllocator<T>>;
+
+}  // namespace mc
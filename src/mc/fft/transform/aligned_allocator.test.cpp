@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft: AlignedAllocator", "[dsp][fft]")
+{
+    auto buffer = AlignedVector<float>(37);
+    REQUIRE(isSimdAligned(buffer.data()));
+    REQUIRE(isSimdAligned(AlignedVector<Complex<float>>(3).data()));
+
+    buffer.resize(1024);
+    REQUIRE(isSimdAligned(buffer.data()));
+    REQUIRE(AlignedAllocator<float>{} == AlignedAllocator<double>{});
+}
+
+TEST_CASE("fft: PFFFT work span", "[dsp][fft]")
+{
+    auto const size  = size_t{256};
+    auto const input = generateRandomTestData(size);
+
+    auto in       = AlignedVector<float>(input.begin(), input.end());
+    auto expected = AlignedVector<Complex<float>>(packedSpectrumSize(size));
+    auto output   = AlignedVector<Complex<float>>(packedSpectrumSize(size));
+
+    auto engine = PFFFT_Real_Float{size};
+    auto work   = AlignedVector<float>(engine.workSize());
+    engine.rfftPacked(in, expected);
+    engine.rfftPacked(in, output, work);
+    REQUIRE(output == expected);
+
+    auto complexEngine = PFFFT_Complex_Float{size};
+    auto complexWork   = AlignedVector<float>(complexEngine.workSize());
+    auto complexIn     = AlignedVector<Complex<float>>(size);
+    auto complexOut    = AlignedVector<Complex<float>>(size);
+    for (auto i = size_t{0}; i < size; ++i) { complexIn[i] = {input[i], 0.0F}; }
+    complexEngine.fft(complexIn, complexOut, complexWork);
+
+    // Bins of a real input match the packed spectrum, slot 0 holds DC & Nyquist
+    for (auto k = size_t{1}; k < packedSpectrumSize(size); ++k) {
+        REQUIRE(std::abs(complexOut[k] - expected[k]) < 1e-3F);
+    }
+}
+
+TEST_CASE("fft: PFFFT unaligned buffers", "[dsp][fft]")
+{
+    // Subspans shifted by one element are never SIMD aligned, unless pffft is scalar
+    auto const size   = size_t{256};
+    auto const random = generateRandomTestData(size + 1);
+    auto const input  = Span<float const>{random}.subspan(1);
+
+    auto engine   = PFFFT_Real_Float{size};
+    auto in       = AlignedVector<float>(input.begin(), input.end());
+    auto expected = AlignedVector<Complex<float>>(size);
+    engine.rfft(in, expected);
+
+    auto buffer   = Vector<Complex<float>>(size + 1);
+    auto spectrum = Span<Complex<float>>{buffer}.subspan(1);
+    engine.rfft(input, spectrum);
+    REQUIRE(ranges::equal(spectrum, expected));
+
+    auto output = Vector<float>(size + 1);
+    engine.irfft(spectrum, Span<float>{output}.subspan(1));
+    for (auto i = size_t{0}; i < size; ++i) {
+        REQUIRE(std::abs(output[i + 1] / static_cast<float>(size) - input[i]) < 1e-4F);
+    }
+
+    auto packed = Span<Complex<float>>{buffer}.subspan(1, packedSpectrumSize(size));
+    engine.rfftPacked(input, packed);
+    engine.irfftPacked(packed, Span<float>{output}.subspan(1));
+    for (auto i = size_t{0}; i < size; ++i) {
+        REQUIRE(std::abs(output[i + 1] / static_cast<float>(size) - input[i]) < 1e-4F);
+    }
+
+    // The type-erased engines hand unaligned subspans straight to the backend
+    auto complexEngine = makeFFT(size);
+    auto complexIn     = Vector<Complex<float>>(size + 1);
+    for (auto i = size_t{0}; i < size; ++i) { complexIn[i + 1] = {input[i], 0.0F}; }
+    auto const unaligned = Span<Complex<float> const>{complexIn}.subspan(1);
+    fft(complexEngine, unaligned, spectrum);
+    REQUIRE(ranges::equal(spectrum, expected, [](auto l, auto r) {
+        return std::abs(l - r) < 1e-3F;
+    }));
+}
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "bluestein.hpp"
+
+#include <mc/fft/algorithm/spectral_multiply.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/iterator.hpp>
+#include <mc/core/numbers.hpp>
+#include <mc/core/stdexcept.hpp>
+
+namespace mc {
+
+namespace {
+auto makeBluesteinHandle(size_t size) -> Bluestein_Handle_Float
+{
+    if (size == 0) { raise<InvalidArgument>("bluestein: size must be greater than zero"); }
+
+    auto key = makePlanKey<float>(size, TransformKind::complex);
+    return bluesteinPlanCache().get(key, [size] {
+        return makeShared<Bluestein_Plan_Float>(size);
+    });
+}
+}  // namespace
+
+Bluestein_Plan_Float::Bluestein_Plan_Float(size_t n)
+    : size{n}
+    , convolutionSize{pffftFastSize(2 * n - 1, TransformKind::complex)}
+    , chirp(n)
+    , filter(convolutionSize)
+{
+    // k^2 is reduced modulo 2N before the division, otherwise the phase loses all
+    // precision for large k.
+    for (auto k = size_t{0}; k < n; ++k) {
+        auto const k2    = (k * k) % (2 * n);
+        auto const phase = -numbers::pi * static_cast<double>(k2) / static_cast<double>(n);
+        chirp[k]         = Complex<float>(std::polar(1.0, phase));
+    }
+
+    auto b = AlignedVector<Complex<float>>(convolutionSize);
+    b[0]   = std::conj(chirp[0]);
+    for (auto k = size_t{1}; k < n; ++k) {
+        b[k]                   = std::conj(chirp[k]);
+        b[convolutionSize - k] = std::conj(chirp[k]);
+    }
+
+    auto engine = PFFFT_Complex_Float{convolutionSize};
+    engine.fft(b, filter);
+
+    auto const scale = 1.0F / static_cast<float>(convolutionSize);
+    for (auto& x : filter) { x *= scale; }
+}
+
+auto bluesteinPlanCache() -> PlanCache<Bluestein_Plan_Float const>&
+{
+    static auto cache = PlanCache<Bluestein_Plan_Float const>{};
+    return cache;
+}
+
+Bluestein_Complex_Float::Bluestein_Complex_Float(size_t size)
+    : _plan{makeBluesteinHandle(size)}
+    , _fft{_plan->convolutionSize}
+    , _a(_plan->convolutionSize)
+    , _b(_plan->convolutionSize)
+{}
+
+auto Bluestein_Complex_Float::fft(Span<Complex<float> const> in, Span<Complex<float>> out)
+    -> void
+{
+    transform(in, out, false);
+}
+
+auto Bluestein_Complex_Float::ifft(Span<Complex<float> const> in, Span<Complex<float>> out)
+    -> void
+{
+    transform(in, out, true);
+}
+
+auto Bluestein_Complex_Float::transform(
+    Span<Complex<float> const> in,
+    Span<Complex<float>> out,
+    bool inverse
+) -> void
+{
+    auto const n      = _plan->size;
+    auto const& chirp = _plan->chirp;
+    MC_ASSERT(in.size() >= n);
+    MC_ASSERT(out.size() >= n);
+
+    // The inverse is computed as conj(fft(conj(x)))
+    for (auto k = size_t{0}; k < n; ++k) {
+        _a[k] = (inverse ? std::conj(in[k]) : in[k]) * chirp[k];
+    }
+    std::fill(std::next(_a.begin(), static_cast<ptrdiff_t>(n)), _a.end(), Complex<float>{});
+
+    _fft.fft(_a, _b);
+    spectralMultiply(_b, _plan->filter, _b, false);
+    _fft.ifft(_b, _a);
+
+    for (auto k = size_t{0}; k < n; ++k) {
+        auto const x = _a[k] * chirp[k];
+        out[k]       = inverse ? std::conj(x) : x;
+    }
+}
+
+Bluestein_Real_Float::Bluestein_Real_Float(size_t size)
+    : _size{size}
+    , _fft{size}
+    , _in(size)
+    , _out(size)
+{}
+
+auto Bluestein_Real_Float::rfft(Span<float const> in, Span<Complex<float>> out) -> void
+{
+    MC_ASSERT(in.size() >= _size);
+    for (auto k = size_t{0}; k < _size; ++k) { _in[k] = {in[k], 0.0F}; }
+    _fft.fft(_in, out);
+}
+
+auto Bluestein_Real_Float::irfft(Span<Complex<float> const> in, Span<float> out) -> void
+{
+    MC_ASSERT(in.size() >= _size / 2 + 1);
+    MC_ASSERT(out.size() >= _size);
+
+    // Only the lower half is read, the upper half is rebuilt from the conjugates.
+    auto const h = _size / 2;
+    for (auto k = size_t{0}; k <= h; ++k) { _in[k] = in[k]; }
+    for (auto k = h + 1; k < _size; ++k) { _in[k] = std::conj(in[_size - k]); }
+
+    _fft.ifft(_in, _out);
+    for (auto k = size_t{0}; k < _size; ++k) { out[k] = _out[k].real(); }
+}
+
+auto Bluestein_Real_Float::rfftPacked(Span<float const> in, Span<Complex<float>> out)
+    -> void
+{
+    MC_ASSERT(_size % 2 == 0);
+    MC_ASSERT(out.size() >= _size / 2);
+
+    auto const h     = _size / 2;
+    auto const first = _out.begin();
+    rfft(in, _out);
+    std::copy(first, std::next(first, static_cast<ptrdiff_t>(h)), out.data());
+    out[0] = {_out[0].real(), _out[h].real()};
+}
+
+auto Bluestein_Real_Float::irfftPacked(Span<Complex<float> const> in, Span<float> out)
+    -> void
+{
+    MC_ASSERT(_size % 2 == 0);
+    MC_ASSERT(in.size() >= _size / 2);
+    MC_ASSERT(out.size() >= _size);
+
+    auto const h = _size / 2;
+    _in[0]       = {in[0].real(), 0.0F};
+    _in[h]       = {in[0].imag(), 0.0F};
+    for (auto k = size_t{1}; k < h; ++k) {
+        _in[k]         = in[k];
+        _in[_size - k] = std::conj(in[k]);
+    }
+
+    _fft.ifft(_in, _out);
+    for (auto k = size_t{0}; k < _size; ++k) { out[k] = _out[k].real(); }
+}
+
+}  // namespace mc
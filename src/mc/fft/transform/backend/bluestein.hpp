@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/fft/transform/backend/pffft.hpp>
+#include <mc/fft/transform/plan_cache.hpp>
+
+#include <mc/core/complex.hpp>
+#include <mc/core/memory.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+/// Precomputed chirp & filter spectrum of a size N Bluestein transform. The convolution
+/// runs on a pffft transform of size M = pffftFastSize(2N - 1).
+struct Bluestein_Plan_Float
+{
+    explicit Bluestein_Plan_Float(size_t size);
+
+    size_t size;
+    size_t convolutionSize;
+
+    /// exp(-i*pi*k^2/N), k in [0, N)
+    Vector<Complex<float>> chirp;
+
+    /// FFT of the conjugate chirp filter, already scaled by 1/M.
+    AlignedVector<Complex<float>> filter;
+};
+
+using Bluestein_Handle_Float = SharedPtr<Bluestein_Plan_Float const>;
+
+/// Process wide cache of Bluestein plans, keyed by size.
+[[nodiscard]] auto bluesteinPlanCache() -> PlanCache<Bluestein_Plan_Float const>&;
+
+/// Complex FFT of arbitrary size, computed as a chirp-z convolution on a natively
+/// supported pffft transform. Used as fallback for sizes pffft does not support.
+struct Bluestein_Complex_Float
+{
+    explicit Bluestein_Complex_Float(size_t size);
+
+    auto fft(Span<Complex<float> const> in, Span<Complex<float>> out) -> void;
+    auto ifft(Span<Complex<float> const> in, Span<Complex<float>> out) -> void;
+
+private:
+    auto transform(Span<Complex<float> const> in, Span<Complex<float>> out, bool inverse)
+        -> void;
+
+    Bluestein_Handle_Float _plan;
+    PFFFT_Complex_Float _fft;
+    AlignedVector<Complex<float>> _a;
+    AlignedVector<Complex<float>> _b;
+};
+
+/// Real FFT of arbitrary size on top of Bluestein_Complex_Float. The packed format is
+/// only defined for even sizes.
+struct Bluestein_Real_Float
+{
+    explicit Bluestein_Real_Float(size_t size);
+
+    auto rfft(Span<float const> in, Span<Complex<float>> out) -> void;
+    auto irfft(Span<Complex<float> const> in, Span<float> out) -> void;
+
+    auto rfftPacked(Span<float const> in, Span<Complex<float>> out) -> void;
+    auto irfftPacked(Span<Complex<float> const> in, Span<float> out) -> void;
+
+private:
+    size_t _size;
+    Bluestein_Complex_Float _fft;
+    Vector<Complex<float>> _in;
+    Vector<Complex<float>> _out;
+};
+
+}  // namespace mc
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft: Bluestein_Complex_Float", "[dsp][fft]")
+{
+    auto const size = GENERATE(size_t{1}, size_t{7}, size_t{97}, size_t{1000}, size_t{11025});
+
+    auto input = Vector<Complex<float>>(size);
+    for (auto& x : input) { x = {generateRnd(), generateRnd()}; }
+
+    // generateRnd is in [1, 100), the DC bin grows to 100 * size
+    auto const tolerance = 1e-4F * static_cast<float>(size);
+    auto closeEnough     = [tolerance](auto l, auto r) { return std::abs(l - r) < tolerance; };
+
+    auto expected  = Vector<Complex<float>>(size);
+    auto reference = FFTW_Complex_Float{size};
+    reference.fft(input, expected);
+
+    auto engine = makeFFT(size);
+    auto output = Vector<Complex<float>>(size);
+    fft(engine, input, output);
+    REQUIRE(ranges::equal(output, expected, closeEnough));
+
+    reference.ifft(input, expected);
+    ifft(engine, input, output);
+    REQUIRE(ranges::equal(output, expected, closeEnough));
+}
+
+TEST_CASE("fft: Bluestein_Real_Float", "[dsp][fft]")
+{
+    auto const size  = GENERATE(size_t{7}, size_t{98}, size_t{11025});
+    auto const input = generateRandomTestData(size);
+
+    auto engine   = makeRFFT(size);
+    auto spectrum = Vector<Complex<float>>(size);
+    auto output   = Vector<float>(size);
+    rfft(engine, input, spectrum);
+    irfft(engine, spectrum, output);
+
+    auto const scale = static_cast<float>(size);
+    REQUIRE(ranges::equal(output, input, [scale](auto l, auto r) {
+        return std::abs(l / scale - r) < 1e-4F;
+    }));
+
+    if (size % 2 == 0) {
+        auto packed = Vector<Complex<float>>(packedSpectrumSize(size));
+        rfftPacked(engine, input, packed);
+        irfftPacked(engine, packed, output);
+        REQUIRE(ranges::equal(output, input, [scale](auto l, auto r) {
+            return std::abs(l / scale - r) < 1e-4F;
+        }));
+    }
+}
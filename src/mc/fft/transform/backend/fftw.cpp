@@ -0,0 +1,474 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "fftw.hpp"
+
+#include <mc/fft/transform/simd.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/atomic.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/iterator.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/utility.hpp>
+
+namespace mc {
+
+namespace {
+
+template<typename FloatT>
+struct FFTWApi;
+
+template<>
+struct FFTWApi<float>
+{
+    using plan_type    = fftwf_plan;
+    using complex_type = fftwf_complex;
+
+    static constexpr auto alignment_of    = fftwf_alignment_of;
+    static constexpr auto plan_dft_1d     = fftwf_plan_dft_1d;
+    static constexpr auto plan_dft_r2c_1d = fftwf_plan_dft_r2c_1d;
+    static constexpr auto plan_dft_c2r_1d = fftwf_plan_dft_c2r_1d;
+    static constexpr auto plan_r2r_1d     = fftwf_plan_r2r_1d;
+    static constexpr auto execute_dft     = fftwf_execute_dft;
+    static constexpr auto execute_dft_r2c = fftwf_execute_dft_r2c;
+    static constexpr auto execute_dft_c2r = fftwf_execute_dft_c2r;
+    static constexpr auto execute_r2r     = fftwf_execute_r2r;
+    static constexpr auto destroy_plan    = fftwf_destroy_plan;
+    static constexpr auto import_wisdom   = fftwf_import_wisdom_from_filename;
+    static constexpr auto export_wisdom   = fftwf_export_wisdom_to_filename;
+};
+
+template<>
+struct FFTWApi<double>
+{
+    using plan_type    = fftw_plan;
+    using complex_type = fftw_complex;
+
+    static constexpr auto alignment_of    = fftw_alignment_of;
+    static constexpr auto plan_dft_1d     = fftw_plan_dft_1d;
+    static constexpr auto plan_dft_r2c_1d = fftw_plan_dft_r2c_1d;
+    static constexpr auto plan_dft_c2r_1d = fftw_plan_dft_c2r_1d;
+    static constexpr auto plan_r2r_1d     = fftw_plan_r2r_1d;
+    static constexpr auto execute_dft     = fftw_execute_dft;
+    static constexpr auto execute_dft_r2c = fftw_execute_dft_r2c;
+    static constexpr auto execute_dft_c2r = fftw_execute_dft_c2r;
+    static constexpr auto execute_r2r     = fftw_execute_r2r;
+    static constexpr auto destroy_plan    = fftw_destroy_plan;
+    static constexpr auto import_wisdom   = fftw_import_wisdom_from_filename;
+    static constexpr auto export_wisdom   = fftw_export_wisdom_to_filename;
+};
+
+auto plannerSetting() -> std::atomic<FFTWPlanner>&
+{
+    static auto planner = std::atomic<FFTWPlanner>{FFTWPlanner::estimate};
+    return planner;
+}
+
+auto toFlags(FFTWPlanner planner) -> unsigned
+{
+    switch (planner) {
+        case FFTWPlanner::estimate: return FFTW_ESTIMATE;
+        case FFTWPlanner::measure: return FFTW_MEASURE;
+        case FFTWPlanner::patient: return FFTW_PATIENT;
+    }
+    return FFTW_ESTIMATE;
+}
+
+template<typename FloatT>
+auto isAligned(void const* ptr) -> bool
+{
+    // Plans are created on fftwf_malloc'ed scratch buffers, so user arrays can only be
+    // passed to the new-array execute functions if they share the same alignment.
+    auto* p = static_cast<FloatT*>(const_cast<void*>(ptr));  // NOLINT
+    return FFTWApi<FloatT>::alignment_of(p) == 0;
+}
+
+template<typename FloatT>
+auto toFFTW(Complex<FloatT> const* ptr)
+{
+    using complex_type = typename FFTWApi<FloatT>::complex_type;
+    return reinterpret_cast<complex_type*>(const_cast<Complex<FloatT>*>(ptr));  // NOLINT
+}
+
+template<typename T>
+auto allocate(size_t size) -> UniquePtr<T, FFTW_Deleter>
+{
+    return UniquePtr<T, FFTW_Deleter>{static_cast<T*>(fftwf_malloc(sizeof(T) * size))};
+}
+
+template<typename FloatT, typename Plan>
+auto makeHandle(Plan fwd, Plan bwd) -> FFTW_Handle<FloatT>
+{
+    if (fwd == nullptr || bwd == nullptr) {
+        if (fwd != nullptr) { FFTWApi<FloatT>::destroy_plan(fwd); }
+        if (bwd != nullptr) { FFTWApi<FloatT>::destroy_plan(bwd); }
+        return {};
+    }
+    return makeShared<FFTW_Plan<FloatT>>(fwd, bwd);
+}
+
+template<typename FloatT>
+auto makeComplexPlan(size_t size, unsigned flags) -> FFTW_Handle<FloatT>
+{
+    using Api = FFTWApi<FloatT>;
+
+    auto const n   = static_cast<int>(size);
+    auto const in  = allocate<Complex<FloatT>>(size);
+    auto const out = allocate<Complex<FloatT>>(size);
+
+    auto* src = toFFTW<FloatT>(in.get());
+    auto* dst = toFFTW<FloatT>(out.get());
+
+    auto const lock = std::scoped_lock{fftwPlannerMutex()};
+    auto* fwd       = Api::plan_dft_1d(n, src, dst, FFTW_FORWARD, flags);
+    auto* bwd       = Api::plan_dft_1d(n, src, dst, FFTW_BACKWARD, flags);
+    return makeHandle<FloatT>(fwd, bwd);
+}
+
+template<typename FloatT>
+auto makeRealPlan(size_t size, unsigned flags) -> FFTW_Handle<FloatT>
+{
+    using Api = FFTWApi<FloatT>;
+
+    auto const n        = static_cast<int>(size);
+    auto const real     = allocate<FloatT>(size);
+    auto const spectrum = allocate<Complex<FloatT>>(size / 2 + 1);
+
+    auto* time = real.get();
+    auto* freq = toFFTW<FloatT>(spectrum.get());
+
+    auto const lock = std::scoped_lock{fftwPlannerMutex()};
+    auto* fwd       = Api::plan_dft_r2c_1d(n, time, freq, flags);
+    auto* bwd       = Api::plan_dft_c2r_1d(n, freq, time, flags);
+    return makeHandle<FloatT>(fwd, bwd);
+}
+
+auto isDCT(TransformKind kind) -> bool
+{
+    return kind == TransformKind::dct2 || kind == TransformKind::dct3
+        || kind == TransformKind::dct4;
+}
+
+// The backward plan runs the inverse kind.
+template<typename FloatT>
+auto makeDCTPlan(size_t size, TransformKind kind, unsigned flags) -> FFTW_Handle<FloatT>
+{
+    using Api = FFTWApi<FloatT>;
+
+    auto const n   = static_cast<int>(size);
+    auto const in  = allocate<FloatT>(size);
+    auto const out = allocate<FloatT>(size);
+
+    auto fwdKind = FFTW_REDFT11;
+    auto bwdKind = FFTW_REDFT11;
+    if (kind == TransformKind::dct2) {
+        fwdKind = FFTW_REDFT10;
+        bwdKind = FFTW_REDFT01;
+    } else if (kind == TransformKind::dct3) {
+        fwdKind = FFTW_REDFT01;
+        bwdKind = FFTW_REDFT10;
+    }
+
+    auto const lock = std::scoped_lock{fftwPlannerMutex()};
+    auto* fwd       = Api::plan_r2r_1d(n, in.get(), out.get(), fwdKind, flags);
+    auto* bwd       = Api::plan_r2r_1d(n, in.get(), out.get(), bwdKind, flags);
+    return makeHandle<FloatT>(fwd, bwd);
+}
+
+template<typename FloatT>
+auto makeDCTHandle(size_t size, TransformKind kind, FFTWPlanner planner)
+    -> FFTW_Handle<FloatT>
+{
+    if (not isDCT(kind)) { raise<InvalidArgument>("fftw: kind is not a dct"); }
+    return makeFFTWHandle<FloatT>(size, kind, planner);
+}
+
+}  // namespace
+
+auto fftwPlanner() -> FFTWPlanner { return plannerSetting().load(); }
+
+auto setFFTWPlanner(FFTWPlanner planner) -> void { plannerSetting() = planner; }
+
+auto fftwPlannerMutex() -> std::mutex&
+{
+    static auto mutex = std::mutex{};
+    return mutex;
+}
+
+auto loadFFTWWisdom(String const& path, TransformPrecision precision) -> bool
+{
+    auto const lock = std::scoped_lock{fftwPlannerMutex()};
+    if (precision == TransformPrecision::float64) {
+        return FFTWApi<double>::import_wisdom(path.c_str()) != 0;
+    }
+    return FFTWApi<float>::import_wisdom(path.c_str()) != 0;
+}
+
+auto saveFFTWWisdom(String const& path, TransformPrecision precision) -> bool
+{
+    auto const lock = std::scoped_lock{fftwPlannerMutex()};
+    if (precision == TransformPrecision::float64) {
+        return FFTWApi<double>::export_wisdom(path.c_str()) != 0;
+    }
+    return FFTWApi<float>::export_wisdom(path.c_str()) != 0;
+}
+
+template<typename FloatT>
+FFTW_Plan<FloatT>::FFTW_Plan(plan_type fwd, plan_type bwd)
+    : forward{fwd}
+    , backward{bwd}
+{}
+
+template<typename FloatT>
+FFTW_Plan<FloatT>::~FFTW_Plan()
+{
+    auto const lock = std::scoped_lock{fftwPlannerMutex()};
+    FFTWApi<FloatT>::destroy_plan(forward);
+    FFTWApi<FloatT>::destroy_plan(backward);
+}
+
+template<typename FloatT>
+auto fftwPlanCache() -> PlanCache<FFTW_Plan<FloatT>>&
+{
+    static auto cache = PlanCache<FFTW_Plan<FloatT>>{};
+    return cache;
+}
+
+template<typename FloatT>
+auto makeFFTWHandle(size_t size, TransformKind kind, FFTWPlanner planner)
+    -> FFTW_Handle<FloatT>
+{
+    if (size == 0) { raise<InvalidArgument>("fftw: size must be greater than zero"); }
+
+    auto flags = toFlags(planner);
+    if (simdLevel() == SimdLevel::scalar) { flags |= FFTW_NO_SIMD; }
+
+    auto key  = makePlanKey<FloatT>(size, kind);
+    key.flags = flags;
+
+    auto handle = fftwPlanCache<FloatT>().get(key, [size, kind, flags] {
+        if (kind == TransformKind::real) { return makeRealPlan<FloatT>(size, flags); }
+        if (isDCT(kind)) { return makeDCTPlan<FloatT>(size, kind, flags); }
+        return makeComplexPlan<FloatT>(size, flags);
+    });
+
+    if (handle == nullptr) { raisef<InvalidArgument>("fftw: cannot plan size {}", size); }
+    return handle;
+}
+
+template<typename FloatT>
+FFTW_Complex<FloatT>::FFTW_Complex(size_t size, FFTWPlanner planner)
+    : _size{size}
+    , _plan{makeFFTWHandle<FloatT>(size, TransformKind::complex, planner)}
+    , _in{allocate<Complex<FloatT>>(size)}
+    , _out{allocate<Complex<FloatT>>(size)}
+{}
+
+template<typename FloatT>
+auto FFTW_Complex<FloatT>::fft(Span<Complex<FloatT> const> in, Span<Complex<FloatT>> out)
+    -> void
+{
+    execute(_plan->forward, in, out);
+}
+
+template<typename FloatT>
+auto FFTW_Complex<FloatT>::ifft(Span<Complex<FloatT> const> in, Span<Complex<FloatT>> out)
+    -> void
+{
+    execute(_plan->backward, in, out);
+}
+
+template<typename FloatT>
+auto FFTW_Complex<FloatT>::execute(
+    plan_type plan,
+    Span<Complex<FloatT> const> in,
+    Span<Complex<FloatT>> out
+) -> void
+{
+    MC_ASSERT(in.size() >= _size);
+    MC_ASSERT(out.size() >= _size);
+
+    auto const size = static_cast<ptrdiff_t>(_size);
+
+    // The plans are out-of-place, in-place calls go through the scratch buffers as well.
+    auto const inPlace = in.data() == out.data();
+
+    auto const* src = in.data();
+    if (inPlace || not isAligned<FloatT>(src)) {
+        std::copy(in.data(), std::next(in.data(), size), _in.get());
+        src = _in.get();
+    }
+
+    auto* dst = inPlace || not isAligned<FloatT>(out.data()) ? _out.get() : out.data();
+    FFTWApi<FloatT>::execute_dft(plan, toFFTW<FloatT>(src), toFFTW<FloatT>(dst));
+
+    if (dst != out.data()) { std::copy(dst, std::next(dst, size), out.data()); }
+}
+
+template<typename FloatT>
+FFTW_Real<FloatT>::FFTW_Real(size_t size, FFTWPlanner planner)
+    : _size{size}
+    , _plan{makeFFTWHandle<FloatT>(size, TransformKind::real, planner)}
+    , _real{allocate<FloatT>(size)}
+    , _spectrum{allocate<Complex<FloatT>>(size / 2 + 1)}
+{}
+
+template<typename FloatT>
+auto FFTW_Real<FloatT>::rfft(Span<FloatT const> in, Span<Complex<FloatT>> out) -> void
+{
+    MC_ASSERT(out.size() >= _size);
+
+    auto const n = _size;
+    auto const h = n / 2;
+
+    auto* dst = isAligned<FloatT>(out.data()) ? out.data() : _spectrum.get();
+    forward(in, dst);
+    if (dst != out.data()) {
+        std::copy(dst, std::next(dst, static_cast<ptrdiff_t>(h + 1)), out.data());
+    }
+
+    // Fill upper half with conjugate
+    for (auto i = h + 1; i < n; ++i) { out[i] = std::conj(out[n - i]); }
+}
+
+template<typename FloatT>
+auto FFTW_Real<FloatT>::irfft(Span<Complex<FloatT> const> in, Span<FloatT> out) -> void
+{
+    MC_ASSERT(in.size() >= _size / 2 + 1);
+
+    // c2r destroys its input, so the half spectrum is always copied.
+    auto const bins = static_cast<ptrdiff_t>(_size / 2 + 1);
+    std::copy(in.data(), std::next(in.data(), bins), _spectrum.get());
+    backward(out);
+}
+
+template<typename FloatT>
+auto FFTW_Real<FloatT>::rfftPacked(Span<FloatT const> in, Span<Complex<FloatT>> out)
+    -> void
+{
+    MC_ASSERT(_size % 2 == 0);
+    MC_ASSERT(out.size() >= _size / 2);
+
+    auto const h = static_cast<ptrdiff_t>(_size / 2);
+    forward(in, _spectrum.get());
+    std::copy(_spectrum.get(), std::next(_spectrum.get(), h), out.data());
+    out[0] = {_spectrum.get()[0].real(), _spectrum.get()[h].real()};
+}
+
+template<typename FloatT>
+auto FFTW_Real<FloatT>::irfftPacked(Span<Complex<FloatT> const> in, Span<FloatT> out)
+    -> void
+{
+    MC_ASSERT(_size % 2 == 0);
+    MC_ASSERT(in.size() >= _size / 2);
+
+    auto const h = static_cast<ptrdiff_t>(_size / 2);
+    std::copy(in.data(), std::next(in.data(), h), _spectrum.get());
+    _spectrum.get()[0] = {in[0].real(), FloatT{0}};
+    _spectrum.get()[h] = {in[0].imag(), FloatT{0}};
+    backward(out);
+}
+
+template<typename FloatT>
+auto FFTW_Real<FloatT>::forward(Span<FloatT const> in, Complex<FloatT>* out) -> void
+{
+    MC_ASSERT(in.size() >= _size);
+    MC_ASSERT(isAligned<FloatT>(out));
+
+    auto* src = const_cast<FloatT*>(in.data());  // NOLINT
+    if (not isAligned<FloatT>(src)) {
+        auto const n = static_cast<ptrdiff_t>(_size);
+        std::copy(in.data(), std::next(in.data(), n), _real.get());
+        src = _real.get();
+    }
+
+    FFTWApi<FloatT>::execute_dft_r2c(_plan->forward, src, toFFTW<FloatT>(out));
+}
+
+template<typename FloatT>
+auto FFTW_Real<FloatT>::backward(Span<FloatT> out) -> void
+{
+    MC_ASSERT(out.size() >= _size);
+
+    auto* dst = isAligned<FloatT>(out.data()) ? out.data() : _real.get();
+    FFTWApi<FloatT>::execute_dft_c2r(_plan->backward, toFFTW<FloatT>(_spectrum.get()), dst);
+
+    if (dst != out.data()) {
+        std::copy(dst, std::next(dst, static_cast<ptrdiff_t>(_size)), out.data());
+    }
+}
+
+template<typename FloatT>
+FFTW_DCT<FloatT>::FFTW_DCT(size_t size, TransformKind kind, FFTWPlanner planner)
+    : _size{size}
+    , _kind{kind}
+    , _plan{makeDCTHandle<FloatT>(size, kind, planner)}
+    , _in{allocate<FloatT>(size)}
+    , _out{allocate<FloatT>(size)}
+{}
+
+template<typename FloatT>
+auto FFTW_DCT<FloatT>::size() const noexcept -> size_t
+{
+    return _size;
+}
+
+template<typename FloatT>
+auto FFTW_DCT<FloatT>::kind() const noexcept -> TransformKind
+{
+    return _kind;
+}
+
+template<typename FloatT>
+auto FFTW_DCT<FloatT>::dct(Span<FloatT const> in, Span<FloatT> out) -> void
+{
+    execute(_plan->forward, in, out);
+}
+
+template<typename FloatT>
+auto FFTW_DCT<FloatT>::idct(Span<FloatT const> in, Span<FloatT> out) -> void
+{
+    execute(_plan->backward, in, out);
+}
+
+template<typename FloatT>
+auto FFTW_DCT<FloatT>::execute(plan_type plan, Span<FloatT const> in, Span<FloatT> out)
+    -> void
+{
+    MC_ASSERT(in.size() >= _size);
+    MC_ASSERT(out.size() >= _size);
+
+    auto const size    = static_cast<ptrdiff_t>(_size);
+    auto const inPlace = in.data() == out.data();
+
+    auto* src = const_cast<FloatT*>(in.data());  // NOLINT
+    if (inPlace || not isAligned<FloatT>(src)) {
+        std::copy(in.data(), std::next(in.data(), size), _in.get());
+        src = _in.get();
+    }
+
+    auto* dst = inPlace || not isAligned<FloatT>(out.data()) ? _out.get() : out.data();
+    FFTWApi<FloatT>::execute_r2r(plan, src, dst);
+
+    if (dst != out.data()) { std::copy(dst, std::next(dst, size), out.data()); }
+}
+
+template auto fftwPlanCache<float>() -> PlanCache<FFTW_Plan<float>>&;
+template auto fftwPlanCache<double>() -> PlanCache<FFTW_Plan<double>>&;
+
+template auto makeFFTWHandle<float>(size_t, TransformKind, FFTWPlanner)
+    -> FFTW_Handle<float>;
+template auto makeFFTWHandle<double>(size_t, TransformKind, FFTWPlanner)
+    -> FFTW_Handle<double>;
+
+template struct FFTW_Plan<float>;
+template struct FFTW_Plan<double>;
+template struct FFTW_Complex<float>;
+template struct FFTW_Complex<double>;
+template struct FFTW_Real<float>;
+template struct FFTW_Real<double>;
+template struct FFTW_DCT<float>;
+template struct FFTW_DCT<double>;
+
+}  // namespace mc
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/fft/transform/plan_cache.hpp>
+
+#include <mc/core/complex.hpp>
+#include <mc/core/memory.hpp>
+#include <mc/core/mutex.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/string.hpp>
+#include <mc/core/type_traits.hpp>
+
+#include <fftw3.h>
+
+namespace mc {
+
+/// Planner rigor. Higher levels take longer to plan, but usually result in faster
+/// transforms. Measured plans are remembered in the FFTW wisdom, see saveFFTWWisdom.
+enum struct FFTWPlanner
+{
+    estimate,
+    measure,
+    patient,
+};
+
+/// Planner rigor of the FFTW engines created by makeFFT, makeRFFT & makeDCT, e.g. for
+/// modwtFft. Defaults to estimate, which keeps single precision on pffft. measure &
+/// patient also route single precision through FFTW, whose measured plans often beat
+/// pffft on large non-power-of-two sizes. Read when an engine is created.
+[[nodiscard]] auto fftwPlanner() -> FFTWPlanner;
+auto setFFTWPlanner(FFTWPlanner planner) -> void;
+
+/// The FFTW planner is not thread-safe. Every call into the planner (creating or
+/// destroying plans, wisdom import/export) has to hold this lock.
+[[nodiscard]] auto fftwPlannerMutex() -> std::mutex&;
+
+/// Imports FFTW wisdom from a file written by saveFFTWWisdom. Returns false if the file
+/// does not exist or could not be parsed. Single & double precision have separate wisdom.
+auto loadFFTWWisdom(
+    String const& path,
+    TransformPrecision precision = TransformPrecision::float32
+) -> bool;
+
+/// Exports the accumulated FFTW wisdom, i.e. all measured plans, to a file.
+auto saveFFTWWisdom(
+    String const& path,
+    TransformPrecision precision = TransformPrecision::float32
+) -> bool;
+
+struct FFTW_Deleter
+{
+    auto operator()(void* ptr) { fftwf_free(ptr); }
+};
+
+/// Forward & backward plan for one size. Plans are created on private scratch buffers
+/// and only ever executed through the new-array execute functions.
+template<typename FloatT>
+struct FFTW_Plan
+{
+    using plan_type
+        = std::conditional_t<std::is_same_v<FloatT, float>, fftwf_plan, fftw_plan>;
+
+    FFTW_Plan(plan_type forward, plan_type backward);
+    ~FFTW_Plan();
+
+    FFTW_Plan(FFTW_Plan const& other)                    = delete;
+    auto operator=(FFTW_Plan const& other) -> FFTW_Plan& = delete;
+
+    plan_type forward;
+    plan_type backward;
+};
+
+template<typename FloatT>
+using FFTW_Handle = SharedPtr<FFTW_Plan<FloatT>>;
+
+/// Process wide cache of FFTW plans, keyed by size, transform kind & planner rigor.
+template<typename FloatT>
+[[nodiscard]] auto fftwPlanCache() -> PlanCache<FFTW_Plan<FloatT>>&;
+
+template<typename FloatT>
+[[nodiscard]] auto makeFFTWHandle(size_t size, TransformKind kind, FFTWPlanner planner)
+    -> FFTW_Handle<FloatT>;
+
+template<typename FloatT>
+struct FFTW_Complex
+{
+    explicit FFTW_Complex(size_t size, FFTWPlanner planner = FFTWPlanner::estimate);
+
+    auto fft(Span<Complex<FloatT> const> in, Span<Complex<FloatT>> out) -> void;
+    auto ifft(Span<Complex<FloatT> const> in, Span<Complex<FloatT>> out) -> void;
+
+private:
+    using plan_type = typename FFTW_Plan<FloatT>::plan_type;
+
+    auto
+    execute(plan_type plan, Span<Complex<FloatT> const> in, Span<Complex<FloatT>> out)
+        -> void;
+
+    size_t _size;
+    FFTW_Handle<FloatT> _plan;
+
+    // Used for arrays which don't have the alignment the plan was created with.
+    UniquePtr<Complex<FloatT>, FFTW_Deleter> _in;
+    UniquePtr<Complex<FloatT>, FFTW_Deleter> _out;
+};
+
+template<typename FloatT>
+struct FFTW_Real
+{
+    explicit FFTW_Real(size_t size, FFTWPlanner planner = FFTWPlanner::estimate);
+
+    auto rfft(Span<FloatT const> in, Span<Complex<FloatT>> out) -> void;
+    auto irfft(Span<Complex<FloatT> const> in, Span<FloatT> out) -> void;
+
+    auto rfftPacked(Span<FloatT const> in, Span<Complex<FloatT>> out) -> void;
+    auto irfftPacked(Span<Complex<FloatT> const> in, Span<FloatT> out) -> void;
+
+private:
+    auto forward(Span<FloatT const> in, Complex<FloatT>* out) -> void;
+    auto backward(Span<FloatT> out) -> void;
+
+    size_t _size;
+    FFTW_Handle<FloatT> _plan;
+
+    // c2r transforms overwrite their input, so the half spectrum is always copied here.
+    UniquePtr<FloatT, FFTW_Deleter> _real;
+    UniquePtr<Complex<FloatT>, FFTW_Deleter> _spectrum;
+};
+
+/// Real-to-real cosine transform in FFTW's unnormalized REDFT convention, kind is one of
+/// TransformKind::dct2, dct3 or dct4. E.g. dct2 computes
+/// y[k] = 2 * sum_j x[j] * cos(pi * (j + 1/2) * k / N). idct runs the inverse kind, dct2
+/// & dct3 invert each other and dct4 inverts itself, each up to a factor of 2N.
+template<typename FloatT>
+struct FFTW_DCT
+{
+    FFTW_DCT(size_t size, TransformKind kind, FFTWPlanner planner = FFTWPlanner::estimate);
+
+    [[nodiscard]] auto size() const noexcept -> size_t;
+    [[nodiscard]] auto kind() const noexcept -> TransformKind;
+
+    auto dct(Span<FloatT const> in, Span<FloatT> out) -> void;
+    auto idct(Span<FloatT const> in, Span<FloatT> out) -> void;
+
+private:
+    using plan_type = typename FFTW_Plan<FloatT>::plan_type;
+
+    auto execute(plan_type plan, Span<FloatT const> in, Span<FloatT> out) -> void;
+
+    size_t _size;
+    TransformKind _kind;
+    FFTW_Handle<FloatT> _plan;
+
+    // Used for arrays which don't have the alignment the plan was created with.
+    UniquePtr<FloatT, FFTW_Deleter> _in;
+    UniquePtr<FloatT, FFTW_Deleter> _out;
+};
+
+extern template struct FFTW_Plan<float>;
+extern template struct FFTW_Plan<double>;
+extern template struct FFTW_Complex<float>;
+extern template struct FFTW_Complex<double>;
+extern template struct FFTW_Real<float>;
+extern template struct FFTW_Real<double>;
+extern template struct FFTW_DCT<float>;
+extern template struct FFTW_DCT<double>;
+
+using FFTW_Complex_Float  = FFTW_Complex<float>;
+using FFTW_Complex_Double = FFTW_Complex<double>;
+using FFTW_Real_Float     = FFTW_Real<float>;
+using FFTW_Real_Double    = FFTW_Real<double>;
+using FFTW_DCT_Float      = FFTW_DCT<float>;
+using FFTW_DCT_Double     = FFTW_DCT<double>;
+
+}  // namespace mc
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/cstdio.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+namespace {
+auto closeEnough = [](auto l, auto r) { return std::abs(l - r) < 1e-3F; };
+}
+
+TEST_CASE("fft: FFTW_Complex_Float", "[dsp][fft]")
+{
+    auto const size    = size_t{256};
+    auto const planner = GENERATE(FFTWPlanner::estimate, FFTWPlanner::measure);
+
+    auto const real = generateRandomTestData(size * 2);
+    auto input      = Vector<Complex<float>>(size);
+    for (auto i = size_t{0}; i < size; ++i) { input[i] = {real[i * 2], real[i * 2 + 1]}; }
+
+    auto expected  = Vector<Complex<float>>(size);
+    auto reference = makeFFT(size);
+    fft(reference, input, expected);
+
+    auto engine = FFT<float>{FFTW_Complex_Float{size, planner}};
+    auto output = Vector<Complex<float>>(size);
+    fft(engine, input, output);
+    REQUIRE(ranges::equal(output, expected, closeEnough));
+
+    // Unaligned arrays are copied through the engines scratch buffers.
+    auto buffer    = Vector<Complex<float>>(size + 1);
+    auto unaligned = Span<Complex<float>>{buffer}.subspan(1);
+    ranges::copy(input, ranges::begin(unaligned));
+    fft(engine, unaligned, unaligned);
+    REQUIRE(ranges::equal(unaligned, expected, closeEnough));
+
+    ifft(engine, expected, output);
+    for (auto& x : output) { x /= static_cast<float>(size); }
+    REQUIRE(ranges::equal(output, input, closeEnough));
+}
+
+TEST_CASE("fft: FFTW_Real_Float", "[dsp][fft]")
+{
+    auto const size  = GENERATE(size_t{256}, size_t{1000}, size_t{11025 * 2});
+    auto const input = generateRandomTestData(size);
+
+    auto engine   = RFFT<float>{FFTW_Real_Float{size, FFTWPlanner::measure}};
+    auto spectrum = Vector<Complex<float>>(size);
+    rfft(engine, input, spectrum);
+
+    if (size == 256) {
+        auto expected  = Vector<Complex<float>>(size);
+        auto reference = makeRFFT(size);
+        rfft(reference, input, expected);
+        REQUIRE(ranges::equal(spectrum, expected, closeEnough));
+    }
+
+    auto const upper = Span<Complex<float> const>{spectrum}.subspan(size / 2 + 1);
+    auto const lower = Span<Complex<float> const>{spectrum}.subspan(1, upper.size());
+    auto const conj  = [](auto u, auto l) { return u == std::conj(l); };
+    REQUIRE(std::equal(upper.begin(), upper.end(), lower.rbegin(), conj));
+
+    auto output = Vector<float>(size);
+    irfft(engine, spectrum, output);
+    for (auto& x : output) { x /= static_cast<float>(size); }
+    REQUIRE(ranges::equal(output, input, closeEnough));
+}
+
+TEST_CASE("fft: FFTW wisdom", "[dsp][fft]")
+{
+    auto const path = String{"fftw_wisdom.test.txt"};
+
+    auto engine = FFTW_Real_Float{512, FFTWPlanner::measure};
+    REQUIRE(saveFFTWWisdom(path));
+    REQUIRE(loadFFTWWisdom(path));
+    REQUIRE_FALSE(loadFFTWWisdom("does_not_exist.txt"));
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("fft: makeRFFT<double>", "[dsp][fft]")
+{
+    auto const size   = GENERATE(size_t{256}, size_t{11025 * 2});
+    auto const random = generateRandomTestData(size);
+    auto const input  = Vector<double>(random.begin(), random.end());
+
+    auto engine   = makeRFFT<double>(size);
+    auto spectrum = Vector<Complex<double>>(size);
+    auto output   = Vector<double>(size);
+    rfft(engine, input, spectrum);
+    irfft(engine, spectrum, output);
+
+    auto const scale = static_cast<double>(size);
+    REQUIRE(ranges::equal(output, input, [scale](auto l, auto r) {
+        return std::abs(l / scale - r) < 1e-12;
+    }));
+
+    auto complexEngine = makeFFT<double>(size);
+    auto complexInput  = Vector<Complex<double>>(input.begin(), input.end());
+    auto complexOutput = Vector<Complex<double>>(size);
+    fft(complexEngine, complexInput, complexOutput);
+    REQUIRE(ranges::equal(complexOutput, spectrum, [](auto l, auto r) {
+        return std::abs(l - r) < 1e-9;
+    }));
+}
+
+TEST_CASE("fft: setFFTWPlanner", "[dsp][fft]")
+{
+    REQUIRE(fftwPlanner() == FFTWPlanner::estimate);
+    visitRFFT(256, [](auto& engine) {
+        REQUIRE_FALSE(std::is_same_v<std::decay_t<decltype(engine)>, FFTW_Real_Float>);
+    });
+
+    setFFTWPlanner(FFTWPlanner::measure);
+    clearFFTPlanCaches();
+
+    // Single precision moves to FFTW, every path plans with the measure rigor
+    auto const size = size_t{1000};
+    visitFFT(size, [](auto& engine) {
+        REQUIRE(std::is_same_v<std::decay_t<decltype(engine)>, FFTW_Complex_Float>);
+    });
+    visitRFFT(size, [](auto& engine) {
+        REQUIRE(std::is_same_v<std::decay_t<decltype(engine)>, FFTW_Real_Float>);
+    });
+    (void)makeFFT<double>(size);
+    (void)makeDCT<double>(size, TransformKind::dct2);
+
+    auto const planned = fftPlanCacheStats();
+    (void)FFTW_Complex_Float{size, FFTWPlanner::measure};
+    (void)FFTW_Real_Float{size, FFTWPlanner::measure};
+    (void)FFTW_Complex_Double{size, FFTWPlanner::measure};
+    (void)FFTW_DCT_Double{size, TransformKind::dct2, FFTWPlanner::measure};
+    REQUIRE(fftPlanCacheStats().misses == planned.misses);
+    REQUIRE(fftPlanCacheStats().hits == planned.hits + 4U);
+
+    setFFTWPlanner(FFTWPlanner::estimate);
+}
@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "four_step.hpp"
+
+#include <mc/fft/transform/fft.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/atomic.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/numbers.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/thread.hpp>
+
+namespace mc {
+
+namespace {
+
+// Sub-signals per tile. A tile row is 128 bytes, two cache lines.
+constexpr auto tileSize = size_t{16};
+
+// Every sub-signal in a tile starts 64 byte aligned
+[[nodiscard]] auto tileStride(size_t n) -> size_t { return (n + 7U) / 8U * 8U; }
+
+[[nodiscard]] auto hasOnlyFactors235(size_t n) -> bool
+{
+    for (auto const p : {size_t{2}, size_t{3}, size_t{5}}) {
+        while (n % p == 0) { n /= p; }
+    }
+    return n == 1;
+}
+
+auto threadSetting() -> std::atomic<size_t>&
+{
+    static auto threads = std::atomic<size_t>{0};
+    return threads;
+}
+
+}  // namespace
+
+auto fourStepSplit(size_t size) -> size_t
+{
+    auto n1 = static_cast<size_t>(std::sqrt(static_cast<double>(size)));
+    while (n1 * n1 > size) { --n1; }
+
+    for (; n1 >= 16; --n1) {
+        if (size % n1 != 0) { continue; }
+        auto const n2 = size / n1;
+        if (hasOnlyFactors235(n1) && hasOnlyFactors235(n2)) { return n1; }
+    }
+    return 0;
+}
+
+auto fftThreads() -> size_t
+{
+    if (auto const threads = threadSetting().load(); threads != 0) { return threads; }
+    return std::max(size_t{std::thread::hardware_concurrency()}, size_t{1});
+}
+
+auto setFFTThreads(size_t threads) -> void { threadSetting() = threads; }
+
+struct FourStep_Complex_Float::Worker
+{
+    Worker(size_t n1, size_t n2)
+        : stride1{tileStride(n1)}
+        , stride2{tileStride(n2)}
+        , engine1{makeFFT(n1)}
+        , engine2{makeFFT(n2)}
+        , tileIn(tileSize * std::max(stride1, stride2))
+        , tileOut(tileSize * std::max(stride1, stride2))
+    {}
+
+    size_t stride1;
+    size_t stride2;
+    FFT<float> engine1;
+    FFT<float> engine2;
+    AlignedVector<Complex<float>> tileIn;
+    AlignedVector<Complex<float>> tileOut;
+};
+
+FourStep_Complex_Float::FourStep_Complex_Float(size_t size, size_t threads)
+    : _size{size}
+    , _n1{fourStepSplit(size)}
+    , _n2{_n1 == 0 ? 0 : size / _n1}
+{
+    if (_n1 == 0) {
+        raisef<InvalidArgument>("four step: size {} has no split into fast factors", size);
+    }
+    if (threads == 0) {
+        raise<InvalidArgument>("four step: threads must be greater than zero");
+    }
+
+    auto const root = [this](size_t m) {
+        auto const phase = -2.0 * numbers::pi * static_cast<double>(m)
+                         / static_cast<double>(_size);
+        return Complex<float>(std::polar(1.0, phase));
+    };
+
+    _twiddleLo.resize(_n1);
+    _twiddleHi.resize(_n2);
+    for (auto lo = size_t{0}; lo < _n1; ++lo) { _twiddleLo[lo] = root(lo); }
+    for (auto hi = size_t{0}; hi < _n2; ++hi) { _twiddleHi[hi] = root(hi * _n1); }
+
+    _workers.reserve(threads);
+    for (auto i = size_t{0}; i < threads; ++i) { _workers.emplace_back(_n1, _n2); }
+    _buffer.resize(size);
+    _pool = makeUnique<ThreadPool>(threads);
+}
+
+FourStep_Complex_Float::~FourStep_Complex_Float() = default;
+
+FourStep_Complex_Float::FourStep_Complex_Float(FourStep_Complex_Float&& other) noexcept
+    = default;
+
+auto FourStep_Complex_Float::operator=(FourStep_Complex_Float&& other) noexcept
+    -> FourStep_Complex_Float& = default;
+
+auto FourStep_Complex_Float::size() const noexcept -> size_t { return _size; }
+
+auto FourStep_Complex_Float::threads() const noexcept -> size_t { return _workers.size(); }
+
+auto FourStep_Complex_Float::fft(Span<Complex<float> const> in, Span<Complex<float>> out)
+    -> void
+{
+    transform(in, out, false);
+}
+
+auto FourStep_Complex_Float::ifft(Span<Complex<float> const> in, Span<Complex<float>> out)
+    -> void
+{
+    transform(in, out, true);
+}
+
+auto FourStep_Complex_Float::transform(
+    Span<Complex<float> const> in,
+    Span<Complex<float>> out,
+    bool inverse
+) -> void
+{
+    MC_ASSERT(in.size() >= _size);
+    MC_ASSERT(out.size() >= _size);
+
+    // The first pass reads all of the input before the second one writes the output, so
+    // in-place calls are fine.
+    auto columns = [this, in, inverse](Worker& w, size_t first, size_t last) {
+        firstPass(w, in, first, last, inverse);
+    };
+    _pool->run(_workers, _n2, columns);
+
+    auto rows = [this, out, inverse](Worker& w, size_t first, size_t last) {
+        secondPass(w, out, first, last, inverse);
+    };
+    _pool->run(_workers, _n1, rows);
+}
+
+// x[n1 * N2 + n2] -> transform over n1 -> twiddle -> buffer[n2 * N1 + k1]
+auto FourStep_Complex_Float::firstPass(
+    Worker& w,
+    Span<Complex<float> const> in,
+    size_t first,
+    size_t last,
+    bool inverse
+) -> void
+{
+    for (auto c0 = first; c0 < last; c0 += tileSize) {
+        auto const width = std::min(tileSize, last - c0);
+
+        for (auto n1 = size_t{0}; n1 < _n1; ++n1) {
+            auto const* src = &in[n1 * _n2 + c0];
+            for (auto j = size_t{0}; j < width; ++j) {
+                w.tileIn[j * w.stride1 + n1] = src[j];
+            }
+        }
+
+        auto const layout = BatchLayout{_n1, width, w.stride1, w.stride1};
+        forEachInBatch(layout, Span{w.tileIn}, Span{w.tileOut}, [&](auto in, auto out) {
+            if (inverse) {
+                ::mc::ifft(w.engine1, in, out);
+            } else {
+                ::mc::fft(w.engine1, in, out);
+            }
+        });
+
+        for (auto j = size_t{0}; j < width; ++j) {
+            auto const row = Span<Complex<float>>{w.tileOut}.subspan(j * w.stride1, _n1);
+            twiddle(row, c0 + j, inverse);
+            std::copy(row.begin(), row.end(), &_buffer[(c0 + j) * _n1]);
+        }
+    }
+}
+
+// buffer[n2 * N1 + k1] -> transform over n2 -> X[k2 * N1 + k1]
+auto FourStep_Complex_Float::secondPass(
+    Worker& w,
+    Span<Complex<float>> out,
+    size_t first,
+    size_t last,
+    bool inverse
+) -> void
+{
+    for (auto c0 = first; c0 < last; c0 += tileSize) {
+        auto const width = std::min(tileSize, last - c0);
+
+        for (auto n2 = size_t{0}; n2 < _n2; ++n2) {
+            auto const* src = &_buffer[n2 * _n1 + c0];
+            for (auto j = size_t{0}; j < width; ++j) {
+                w.tileIn[j * w.stride2 + n2] = src[j];
+            }
+        }
+
+        auto const layout = BatchLayout{_n2, width, w.stride2, w.stride2};
+        forEachInBatch(layout, Span{w.tileIn}, Span{w.tileOut}, [&](auto in, auto out) {
+            if (inverse) {
+                ::mc::ifft(w.engine2, in, out);
+            } else {
+                ::mc::fft(w.engine2, in, out);
+            }
+        });
+
+        for (auto k2 = size_t{0}; k2 < _n2; ++k2) {
+            auto* dest = &out[k2 * _n1 + c0];
+            for (auto j = size_t{0}; j < width; ++j) {
+                dest[j] = w.tileOut[j * w.stride2 + k2];
+            }
+        }
+    }
+}
+
+// row[k1] *= exp(-2i*pi*n2*k1/N). The exponent m = n2*k1 mod N is tracked as
+// hi * N1 + lo, so the twiddles are exact table products without any drift.
+auto FourStep_Complex_Float::twiddle(Span<Complex<float>> row, size_t n2, bool inverse)
+    const -> void
+{
+    auto const stepLo = n2 % _n1;
+    auto const stepHi = n2 / _n1;
+
+    auto lo = size_t{0};
+    auto hi = size_t{0};
+    for (auto& x : row) {
+        auto const w = _twiddleHi[hi] * _twiddleLo[lo];
+        x *= inverse ? std::conj(w) : w;
+
+        lo += stepLo;
+        hi += stepHi;
+        if (lo >= _n1) {
+            lo -= _n1;
+            ++hi;
+        }
+        if (hi >= _n2) { hi -= _n2; }
+    }
+}
+
+}  // namespace mc
@@ -0,0 +1,93 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/transform/aligned_allocator.hpp>
+#include <mc/fft/transform/thread_pool.hpp>
+
+#include <mc/core/complex.hpp>
+#include <mc/core/cstddef.hpp>
+#include <mc/core/memory.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+/// Complex transforms of at least this size are computed by FourStep_Complex_Float when
+/// created through makeFFT. Below, a single transform fits well enough into the caches.
+inline constexpr auto fourStepThreshold = size_t{1} << 20;
+
+/// Returns the factor N1 of a four-step split size = N1 * N2, or 0 if the size has no
+/// split into two factors of at least 16 with only 2, 3 & 5 as prime factors. N1 is the
+/// largest such factor not greater than sqrt(size).
+[[nodiscard]] auto fourStepSplit(size_t size) -> size_t;
+
+/// Threads used by the four-step engines makeFFT creates. Defaults to the number of
+/// hardware threads, setFFTThreads(0) restores the default.
+[[nodiscard]] auto fftThreads() -> size_t;
+auto setFFTThreads(size_t threads) -> void;
+
+/// Complex FFT for large sizes, computed as N2 transforms of size N1 and N1 transforms
+/// of size N2, see fourStepSplit. Each pass gathers 16 strided sub-signals into
+/// contiguous scratch, transforms them & scatters them back, so every sub-transform
+/// runs in cache and no pass walks memory with a large stride. Both passes are split
+/// across the threads of a pool owned by the engine, each worker owns its engines &
+/// scratch. The threads stay alive between transforms.
+///
+/// Input & output have no alignment requirements and may be the same span.
+struct FourStep_Complex_Float
+{
+    explicit FourStep_Complex_Float(size_t size, size_t threads = 1);
+    ~FourStep_Complex_Float();
+
+    FourStep_Complex_Float(FourStep_Complex_Float&& other) noexcept;
+    auto operator=(FourStep_Complex_Float&& other) noexcept -> FourStep_Complex_Float&;
+
+    [[nodiscard]] auto size() const noexcept -> size_t;
+    [[nodiscard]] auto threads() const noexcept -> size_t;
+
+    auto fft(Span<Complex<float> const> in, Span<Complex<float>> out) -> void;
+    auto ifft(Span<Complex<float> const> in, Span<Complex<float>> out) -> void;
+
+private:
+    struct Worker;
+
+    auto transform(Span<Complex<float> const> in, Span<Complex<float>> out, bool inverse)
+        -> void;
+
+    auto firstPass(
+        Worker& w,
+        Span<Complex<float> const> in,
+        size_t first,
+        size_t last,
+        bool inverse
+    ) -> void;
+
+    auto secondPass(
+        Worker& w,
+        Span<Complex<float>> out,
+        size_t first,
+        size_t last,
+        bool inverse
+    ) -> void;
+
+    auto twiddle(Span<Complex<float>> row, size_t n2, bool inverse) const -> void;
+
+    size_t _size;
+    size_t _n1;
+    size_t _n2;
+
+    // exp(-2i*pi*m/N) for m = hi * N1 + lo, split so both tables are O(sqrt(N))
+    Vector<Complex<float>> _twiddleLo;
+    Vector<Complex<float>> _twiddleHi;
+
+    Vector<Worker> _workers;
+    AlignedVector<Complex<float>> _buffer;
+
+    // Boxed so the engine stays movable, the pool threads point to the pool itself.
+    UniquePtr<ThreadPool> _pool;
+};
+
+}  // namespace mc
@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/cmath.hpp>
+#include <mc/core/tuple.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft: fourStepSplit", "[dsp][fft]")
+{
+    REQUIRE(fourStepSplit(size_t{1} << 22) == size_t{1} << 11);
+    REQUIRE(fourStepSplit(size_t{1} << 23) == size_t{1} << 11);
+    REQUIRE(fourStepSplit(1000 * 1000) == 1000);
+    REQUIRE(fourStepSplit(16 * 24) == 16);
+    REQUIRE(fourStepSplit(255) == 0);
+    REQUIRE(fourStepSplit(16 * 97) == 0);
+}
+
+TEST_CASE("fft: FourStep_Complex_Float", "[dsp][fft]")
+{
+    auto const [size, threads] = GENERATE(
+        std::tuple{size_t{256}, size_t{1}},
+        std::tuple{size_t{16 * 24}, size_t{2}},
+        std::tuple{size_t{4096}, size_t{3}},
+        std::tuple{size_t{45 * 50}, size_t{8}}
+    );
+
+    auto input = Vector<Complex<float>>(size);
+    for (auto& x : input) { x = {generateRnd(), generateRnd()}; }
+
+    // generateRnd is in [1, 100), the DC bin grows to 100 * size
+    auto const tolerance = 1e-4F * static_cast<float>(size);
+    auto closeEnough     = [tolerance](auto l, auto r) { return std::abs(l - r) < tolerance; };
+
+    auto expected  = Vector<Complex<float>>(size);
+    auto reference = FFTW_Complex_Float{size};
+    reference.fft(input, expected);
+
+    auto engine = FourStep_Complex_Float{size, threads};
+    auto output = Vector<Complex<float>>(size);
+    fft(engine, input, output);
+    REQUIRE(ranges::equal(output, expected, closeEnough));
+
+    reference.ifft(input, expected);
+    ifft(engine, input, output);
+    REQUIRE(ranges::equal(output, expected, closeEnough));
+
+    // In-place
+    output = input;
+    fft(engine, output, output);
+    reference.fft(input, expected);
+    REQUIRE(ranges::equal(output, expected, closeEnough));
+
+    // The pool threads survive a move of the engine
+    auto moved = std::move(engine);
+    REQUIRE(moved.threads() == threads);
+    fft(moved, input, output);
+    REQUIRE(ranges::equal(output, expected, closeEnough));
+}
+
+TEST_CASE("fft: makeFFT large size", "[dsp][fft]")
+{
+    auto const size = fourStepThreshold;
+
+    // generateRnd is too slow for a million samples
+    auto input = Vector<Complex<float>>(size);
+    for (auto i = size_t{0}; i < size; ++i) {
+        auto const t = static_cast<float>(i);
+        input[i]     = {std::sin(t * 0.01F), std::cos(t * 0.37F) * 0.5F};
+    }
+
+    auto engine = makeFFT(size);
+    auto output = Vector<Complex<float>>(size);
+    fft(engine, input, output);
+    ifft(engine, output, output);
+
+    auto const scale = 1.0F / static_cast<float>(size);
+    REQUIRE(ranges::equal(output, input, [scale](auto l, auto r) {
+        return std::abs(l * scale - r) < 1e-4F;
+    }));
+}
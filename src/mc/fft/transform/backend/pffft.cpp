@@ -3,48 +3,210 @@
 #include "pffft.hpp"
 
 #include <mc/core/algorithm.hpp>
+#include <mc/core/bit.hpp>
 #include <mc/core/cassert.hpp>
 #include <mc/core/cmath.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/iterator.hpp>
+#include <mc/core/stdexcept.hpp>
 #include <mc/core/utility.hpp>
 
 namespace mc {
 
+namespace {
+// pffft's SIMD path only uses aligned loads & stores. Unaligned input or output is
+// copied through the second half of work, which pffft transforms in place. n is the
+// number of floats of the transform, pffft itself uses the first n floats of work.
+template<typename Transform>
+auto transformStaged(
+    float const* input,
+    float* output,
+    size_t n,
+    Span<float> work,
+    Transform transform
+) -> void
+{
+    MC_ASSERT(work.size() >= 2 * n);
+    MC_ASSERT(isSimdAligned(work.data()));
+
+    if (isSimdAligned(input) && isSimdAligned(output)) {
+        transform(input, output, work.data());
+        return;
+    }
+
+    auto* staging = std::next(work.data(), static_cast<ptrdiff_t>(n));
+    std::copy(input, std::next(input, static_cast<ptrdiff_t>(n)), staging);
+    transform(staging, staging, work.data());
+    std::copy(staging, std::next(staging, static_cast<ptrdiff_t>(n)), output);
+}
+
+auto transformOrdered(
+    PFFFT_Setup* setup,
+    float const* input,
+    float* output,
+    size_t n,
+    Span<float> work,
+    pffft_direction_t direction
+) -> void
+{
+    transformStaged(input, output, n, work, [=](auto const* in, auto* out, auto* tmp) {
+        pffft_transform_ordered(setup, in, out, tmp, direction);
+    });
+}
+
+// Every 2^a * 3^b * 5^c up to 2^32 in ascending order
+auto smoothSizes() -> Vector<size_t> const&
+{
+    static auto const sizes = [] {
+        constexpr auto limit = size_t{1} << 32U;
+
+        auto result = Vector<size_t>{};
+        for (auto p2 = size_t{1}; p2 <= limit; p2 *= 2) {
+            for (auto p3 = p2; p3 <= limit; p3 *= 3) {
+                for (auto p5 = p3; p5 <= limit; p5 *= 5) { result.push_back(p5); }
+            }
+        }
+        ranges::sort(result);
+        return result;
+    }();
+    return sizes;
+}
+}  // namespace
+
+auto pffftFastSize(size_t n, TransformKind kind) -> size_t
+{
+    auto const simd     = static_cast<size_t>(pffft_simd_size());
+    auto const multiple = kind == TransformKind::real ? 2 * simd * simd : simd * simd;
+    auto const isNative = [multiple](size_t size) { return size % multiple == 0; };
+
+    auto const& sizes = smoothSizes();
+    auto const first  = std::lower_bound(sizes.begin(), sizes.end(), n);
+    auto const found  = std::find_if(first, sizes.end(), isNative);
+    if (found != sizes.end()) { return *found; }
+    return std::max(bit_ceil(n), multiple);
+}
+
+auto pffftPlanCache() -> PlanCache<PFFFT_Setup>&
+{
+    static auto cache = PlanCache<PFFFT_Setup>{};
+    return cache;
+}
+
+auto tryMakePFFFTHandle(size_t size, TransformKind kind) -> PFFFT_Handle
+{
+    auto const type = kind == TransformKind::real ? PFFFT_REAL : PFFFT_COMPLEX;
+    return pffftPlanCache().get(makePlanKey<float>(size, kind), [size, type] {
+        auto* setup = pffft_new_setup(static_cast<int>(size), type);
+        if (setup == nullptr) { return PFFFT_Handle{}; }
+        return PFFFT_Handle{setup, PFFFT_Deleter{}};
+    });
+}
+
+auto makePFFFTHandle(size_t size, TransformKind kind) -> PFFFT_Handle
+{
+    auto handle = tryMakePFFFTHandle(size, kind);
+    if (handle == nullptr) { raisef<InvalidArgument>("pffft: unsupported size {}", size); }
+    return handle;
+}
+
 PFFFT_Complex_Float::PFFFT_Complex_Float(size_t size)
-    : _setup{PFFFT_Handle{pffft_new_setup(static_cast<int>(size), PFFFT_COMPLEX)}}
+    : PFFFT_Complex_Float{size, makePFFFTHandle(size, TransformKind::complex)}
 {}
 
+PFFFT_Complex_Float::PFFFT_Complex_Float(size_t size, PFFFT_Handle setup)
+    : _size{size}
+    , _setup{std::move(setup)}
+    , _work(4 * size)
+{
+    MC_ASSERT(_setup != nullptr);
+}
+
+auto PFFFT_Complex_Float::workSize() const noexcept -> size_t { return 4 * _size; }
+
 auto PFFFT_Complex_Float::fft(Span<Complex<float> const> in, Span<Complex<float>> out)
     -> void
 {
-    auto const* input = reinterpret_cast<float const*>(in.data());  // NOLINT
-    auto* output      = reinterpret_cast<float*>(out.data());       // NOLINT
-    pffft_transform_ordered(_setup.get(), input, output, nullptr, PFFFT_FORWARD);
+    fft(in, out, _work);
 }
 
 auto PFFFT_Complex_Float::ifft(Span<Complex<float> const> in, Span<Complex<float>> out)
     -> void
 {
+    ifft(in, out, _work);
+}
+
+auto PFFFT_Complex_Float::fft(
+    Span<Complex<float> const> in,
+    Span<Complex<float>> out,
+    Span<float> work
+) -> void
+{
+    MC_ASSERT(work.size() >= workSize());
     auto const* input = reinterpret_cast<float const*>(in.data());  // NOLINT
     auto* output      = reinterpret_cast<float*>(out.data());       // NOLINT
-    pffft_transform_ordered(_setup.get(), input, output, nullptr, PFFFT_BACKWARD);
+    transformOrdered(_setup.get(), input, output, 2 * _size, work, PFFFT_FORWARD);
+}
+
+auto PFFFT_Complex_Float::ifft(
+    Span<Complex<float> const> in,
+    Span<Complex<float>> out,
+    Span<float> work
+) -> void
+{
+    MC_ASSERT(work.size() >= workSize());
+    auto const* input = reinterpret_cast<float const*>(in.data());  // NOLINT
+    auto* output      = reinterpret_cast<float*>(out.data());       // NOLINT
+    transformOrdered(_setup.get(), input, output, 2 * _size, work, PFFFT_BACKWARD);
 }
 
 PFFFT_Real_Float::PFFFT_Real_Float(size_t n)
+    : PFFFT_Real_Float{n, makePFFFTHandle(n, TransformKind::real)}
+{}
+
+PFFFT_Real_Float::PFFFT_Real_Float(size_t n, PFFFT_Handle setup)
     : _n{static_cast<int>(n)}
-    , _setup{PFFFT_Handle{pffft_new_setup(static_cast<int>(n), PFFFT_REAL)}}
+    , _setup{std::move(setup)}
+    , _work(2 * n)
 {
+    MC_ASSERT(_setup != nullptr);
     _tmp.resize(n);
 }
 
+auto PFFFT_Real_Float::workSize() const noexcept -> size_t
+{
+    return 2 * static_cast<size_t>(_n);
+}
+
 auto PFFFT_Real_Float::rfft(Span<float const> inp, Span<Complex<float>> oup) -> void
 {
-    pffft_transform_ordered(
-        _setup.get(),
-        inp.data(),
-        (float*)oup.data(),
-        nullptr,
-        PFFFT_FORWARD
-    );
+    rfft(inp, oup, _work);
+}
+
+auto PFFFT_Real_Float::irfft(Span<Complex<float> const> inp, Span<float> oup) -> void
+{
+    irfft(inp, oup, _work);
+}
+
+auto PFFFT_Real_Float::rfftPacked(Span<float const> inp, Span<Complex<float>> oup) -> void
+{
+    rfftPacked(inp, oup, _work);
+}
+
+auto PFFFT_Real_Float::irfftPacked(Span<Complex<float> const> inp, Span<float> oup) -> void
+{
+    irfftPacked(inp, oup, _work);
+}
+
+auto PFFFT_Real_Float::rfft(
+    Span<float const> inp,
+    Span<Complex<float>> oup,
+    Span<float> work
+) -> void
+{
+    MC_ASSERT(work.size() >= workSize());
+    auto* out    = reinterpret_cast<float*>(oup.data());  // NOLINT
+    auto const n = static_cast<size_t>(_n);
+    transformOrdered(_setup.get(), inp.data(), out, n, work, PFFFT_FORWARD);
 
     // Move compressed DC/Nyquist components to correct location
     auto const h = _n / 2;
@@ -55,14 +217,190 @@ auto PFFFT_Real_Float::rfft(Span<float const> inp, Span<Complex<float>> oup) ->
     for (auto i = h + 1; i < _n; ++i) { oup[i] = std::conj(oup[_n - i]); }
 }
 
-auto PFFFT_Real_Float::irfft(Span<Complex<float> const> inp, Span<float> oup) -> void
+auto PFFFT_Real_Float::irfft(
+    Span<Complex<float> const> inp,
+    Span<float> oup,
+    Span<float> work
+) -> void
 {
+    MC_ASSERT(work.size() >= workSize());
+
     // Move DC/Nyquist components to compressed location
     ranges::copy(inp, ranges::begin(_tmp));
     _tmp[0] = {_tmp[0].real(), _tmp[_n / 2].real()};
 
-    auto const* in = reinterpret_cast<float const*>(_tmp.data());
-    pffft_transform_ordered(_setup.get(), in, oup.data(), nullptr, PFFFT_BACKWARD);
+    auto const* in = reinterpret_cast<float const*>(_tmp.data());  // NOLINT
+    auto const n   = static_cast<size_t>(_n);
+    transformOrdered(_setup.get(), in, oup.data(), n, work, PFFFT_BACKWARD);
+}
+
+auto PFFFT_Real_Float::rfftPacked(
+    Span<float const> inp,
+    Span<Complex<float>> oup,
+    Span<float> work
+) -> void
+{
+    MC_ASSERT(oup.size() * 2 >= static_cast<size_t>(_n));
+    MC_ASSERT(work.size() >= workSize());
+
+    // pffft's ordered output already is the packed layout.
+    auto* out    = reinterpret_cast<float*>(oup.data());  // NOLINT
+    auto const n = static_cast<size_t>(_n);
+    transformOrdered(_setup.get(), inp.data(), out, n, work, PFFFT_FORWARD);
+}
+
+auto PFFFT_Real_Float::irfftPacked(
+    Span<Complex<float> const> inp,
+    Span<float> oup,
+    Span<float> work
+) -> void
+{
+    MC_ASSERT(inp.size() * 2 >= static_cast<size_t>(_n));
+    MC_ASSERT(work.size() >= workSize());
+
+    auto const* in = reinterpret_cast<float const*>(inp.data());  // NOLINT
+    auto const n   = static_cast<size_t>(_n);
+    transformOrdered(_setup.get(), in, oup.data(), n, work, PFFFT_BACKWARD);
+}
+
+PFFFT_Real_Via_Complex_Float::PFFFT_Real_Via_Complex_Float(size_t n)
+    : PFFFT_Real_Via_Complex_Float{n, makePFFFTHandle(n, TransformKind::complex)}
+{}
+
+PFFFT_Real_Via_Complex_Float::PFFFT_Real_Via_Complex_Float(size_t n, PFFFT_Handle setup)
+    : _n{n}
+    , _fft{n, std::move(setup)}
+    , _in(n)
+    , _out(n)
+{}
+
+auto PFFFT_Real_Via_Complex_Float::rfft(Span<float const> inp, Span<Complex<float>> oup)
+    -> void
+{
+    MC_ASSERT(inp.size() >= _n);
+    MC_ASSERT(oup.size() >= _n);
+
+    for (auto k = size_t{0}; k < _n; ++k) { _in[k] = {inp[k], 0.0F}; }
+    _fft.fft(_in, _out);
+    ranges::copy(_out, oup.begin());
+}
+
+auto PFFFT_Real_Via_Complex_Float::irfft(Span<Complex<float> const> inp, Span<float> oup)
+    -> void
+{
+    MC_ASSERT(inp.size() >= _n / 2 + 1);
+    MC_ASSERT(oup.size() >= _n);
+
+    // Only the lower half is read, the upper half is rebuilt from the conjugates.
+    auto const h = _n / 2;
+    for (auto k = size_t{0}; k <= h; ++k) { _in[k] = inp[k]; }
+    for (auto k = h + 1; k < _n; ++k) { _in[k] = std::conj(inp[_n - k]); }
+
+    _fft.ifft(_in, _out);
+    for (auto k = size_t{0}; k < _n; ++k) { oup[k] = _out[k].real(); }
+}
+
+auto PFFFT_Real_Via_Complex_Float::rfftPacked(
+    Span<float const> inp,
+    Span<Complex<float>> oup
+) -> void
+{
+    MC_ASSERT(_n % 2 == 0);
+    MC_ASSERT(inp.size() >= _n);
+    MC_ASSERT(oup.size() >= _n / 2);
+
+    auto const h = _n / 2;
+    for (auto k = size_t{0}; k < _n; ++k) { _in[k] = {inp[k], 0.0F}; }
+    _fft.fft(_in, _out);
+    std::copy(_out.begin(), std::next(_out.begin(), static_cast<ptrdiff_t>(h)), oup.data());
+    oup[0] = {_out[0].real(), _out[h].real()};
+}
+
+auto PFFFT_Real_Via_Complex_Float::irfftPacked(
+    Span<Complex<float> const> inp,
+    Span<float> oup
+) -> void
+{
+    MC_ASSERT(_n % 2 == 0);
+    MC_ASSERT(inp.size() >= _n / 2);
+    MC_ASSERT(oup.size() >= _n);
+
+    auto const h = _n / 2;
+    _in[0]       = {inp[0].real(), 0.0F};
+    _in[h]       = {inp[0].imag(), 0.0F};
+    for (auto k = size_t{1}; k < h; ++k) {
+        _in[k]      = inp[k];
+        _in[_n - k] = std::conj(inp[k]);
+    }
+
+    _fft.ifft(_in, _out);
+    for (auto k = size_t{0}; k < _n; ++k) { oup[k] = _out[k].real(); }
+}
+
+PFFFT_Convolution_Float::PFFFT_Convolution_Float(size_t n)
+    : _n{n}
+    , _setup{makePFFFTHandle(n, TransformKind::real)}
+    , _work(2 * n)
+{}
+
+auto PFFFT_Convolution_Float::size() const noexcept -> size_t { return _n; }
+
+auto PFFFT_Convolution_Float::forward(Span<float const> input, Span<float> spectrum)
+    -> void
+{
+    forward(input, spectrum, _work);
+}
+
+auto PFFFT_Convolution_Float::backward(Span<float const> spectrum, Span<float> output)
+    -> void
+{
+    backward(spectrum, output, _work);
+}
+
+auto PFFFT_Convolution_Float::forward(
+    Span<float const> input,
+    Span<float> spectrum,
+    Span<float> work
+) -> void
+{
+    MC_ASSERT(input.size() >= _n);
+    MC_ASSERT(spectrum.size() >= _n);
+
+    auto transform = [setup = _setup.get()](auto const* in, auto* out, auto* tmp) {
+        pffft_transform(setup, in, out, tmp, PFFFT_FORWARD);
+    };
+    transformStaged(input.data(), spectrum.data(), _n, work, transform);
+}
+
+auto PFFFT_Convolution_Float::backward(
+    Span<float const> spectrum,
+    Span<float> output,
+    Span<float> work
+) -> void
+{
+    MC_ASSERT(spectrum.size() >= _n);
+    MC_ASSERT(output.size() >= _n);
+
+    auto transform = [setup = _setup.get()](auto const* in, auto* out, auto* tmp) {
+        pffft_transform(setup, in, out, tmp, PFFFT_BACKWARD);
+    };
+    transformStaged(spectrum.data(), output.data(), _n, work, transform);
+}
+
+auto PFFFT_Convolution_Float::convolveAccumulate(
+    Span<float const> a,
+    Span<float const> b,
+    Span<float> ab,
+    float scale
+) -> void
+{
+    MC_ASSERT(a.size() >= _n);
+    MC_ASSERT(b.size() >= _n);
+    MC_ASSERT(ab.size() >= _n);
+    MC_ASSERT(isSimdAligned(a.data()) && isSimdAligned(b.data()));
+    MC_ASSERT(isSimdAligned(ab.data()));
+
+    pffft_zconvolve_accumulate(_setup.get(), a.data(), b.data(), ab.data(), scale);
 }
 
 }  // namespace mc
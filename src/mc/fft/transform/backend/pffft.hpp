@@ -2,6 +2,9 @@
 
 #pragma once
 
+#include <mc/fft/transform/aligned_allocator.hpp>
+#include <mc/fft/transform/plan_cache.hpp>
+
 #include <mc/core/complex.hpp>
 #include <mc/core/memory.hpp>
 #include <mc/core/span.hpp>
@@ -16,33 +19,138 @@ struct PFFFT_Deleter
     auto operator()(PFFFT_Setup* setup) { pffft_destroy_setup(setup); }
 };
 
-using PFFFT_Handle = UniquePtr<PFFFT_Setup, PFFFT_Deleter>;
+/// Shared, immutable pffft setup. Handed out by the process wide pffftPlanCache().
+using PFFFT_Handle = SharedPtr<PFFFT_Setup>;
+
+/// Process wide cache of pffft setups, keyed by size & transform kind.
+[[nodiscard]] auto pffftPlanCache() -> PlanCache<PFFFT_Setup>&;
+
+/// Returns the cached setup for the given size & kind, or nullptr if pffft does not
+/// support the size.
+[[nodiscard]] auto tryMakePFFFTHandle(size_t size, TransformKind kind) -> PFFFT_Handle;
+
+/// Returns the cached setup for the given size & kind. Raises InvalidArgument if pffft
+/// does not support the size.
+[[nodiscard]] auto makePFFFTHandle(size_t size, TransformKind kind) -> PFFFT_Handle;
 
+/// Smallest size >= n that pffft transforms natively. Looked up in a table of the sizes
+/// 2^a * 3^b * 5^c, restricted to multiples of pffft's minimum size for the kind, e.g. 16
+/// for complex & 32 for real transforms with SSE.
+[[nodiscard]] auto pffftFastSize(size_t n, TransformKind kind) -> size_t;
+
+/// pffft's SIMD path needs isSimdAligned input & output, unaligned buffers are copied
+/// through the second half of the work span, so an AlignedVector saves a copy. Work spans
+/// hold workSize() floats & have to be aligned, this is asserted in debug builds. The
+/// overloads without a work span use a buffer owned by the engine, so no transform
+/// allocates.
 struct PFFFT_Complex_Float
 {
     explicit PFFFT_Complex_Float(size_t size);
+    PFFFT_Complex_Float(size_t size, PFFFT_Handle setup);
+
+    /// Size of the work span in floats.
+    [[nodiscard]] auto workSize() const noexcept -> size_t;
 
     auto fft(Span<Complex<float> const> in, Span<Complex<float>> out) -> void;
     auto ifft(Span<Complex<float> const> in, Span<Complex<float>> out) -> void;
 
+    auto fft(Span<Complex<float> const> in, Span<Complex<float>> out, Span<float> work)
+        -> void;
+    auto ifft(Span<Complex<float> const> in, Span<Complex<float>> out, Span<float> work)
+        -> void;
+
 private:
+    size_t _size;
     PFFFT_Handle _setup;
+    AlignedVector<float> _work;
 };
 
+/// Same alignment & work buffer rules as PFFFT_Complex_Float.
 struct PFFFT_Real_Float
 {
     explicit PFFFT_Real_Float(size_t n);
+    PFFFT_Real_Float(size_t n, PFFFT_Handle setup);
+
+    /// Size of the work span in floats.
+    [[nodiscard]] auto workSize() const noexcept -> size_t;
 
     auto rfft(Span<float const> inp, Span<Complex<float>> oup) -> void;
     auto irfft(Span<Complex<float> const> inp, Span<float> oup) -> void;
 
+    auto rfftPacked(Span<float const> inp, Span<Complex<float>> oup) -> void;
+    auto irfftPacked(Span<Complex<float> const> inp, Span<float> oup) -> void;
+
+    auto rfft(Span<float const> inp, Span<Complex<float>> oup, Span<float> work) -> void;
+    auto irfft(Span<Complex<float> const> inp, Span<float> oup, Span<float> work) -> void;
+
+    auto rfftPacked(Span<float const> inp, Span<Complex<float>> oup, Span<float> work)
+        -> void;
+    auto irfftPacked(Span<Complex<float> const> inp, Span<float> oup, Span<float> work)
+        -> void;
+
 private:
     int _n;
     PFFFT_Handle _setup;
+    AlignedVector<float> _work;
 
     // We need to rearrange the inverse transform input
     // and it is passed as const. So we make a copy and modify.
-    Vector<Complex<float>> _tmp;
+    AlignedVector<Complex<float>> _tmp;
+};
+
+/// Real transform on top of a size N complex pffft transform with a zero imaginary part.
+/// Used for sizes the real transform rejects but the complex one accepts, e.g. 48 or 80,
+/// which are still a lot faster than Bluestein. Inputs & outputs go through buffers owned
+/// by the engine, so they do not need to be aligned. The packed format is only defined
+/// for even sizes.
+struct PFFFT_Real_Via_Complex_Float
+{
+    explicit PFFFT_Real_Via_Complex_Float(size_t n);
+    PFFFT_Real_Via_Complex_Float(size_t n, PFFFT_Handle setup);
+
+    auto rfft(Span<float const> inp, Span<Complex<float>> oup) -> void;
+    auto irfft(Span<Complex<float> const> inp, Span<float> oup) -> void;
+
+    auto rfftPacked(Span<float const> inp, Span<Complex<float>> oup) -> void;
+    auto irfftPacked(Span<Complex<float> const> inp, Span<float> oup) -> void;
+
+private:
+    size_t _n;
+    PFFFT_Complex_Float _fft;
+    AlignedVector<Complex<float>> _in;
+    AlignedVector<Complex<float>> _out;
+};
+
+/// Real transform which keeps spectra in pffft's internal (unordered) layout, skipping
+/// the reordering pass of the ordered API. Spectra are N floats in an opaque order, they
+/// can only be multiplied with convolveAccumulate and transformed back. Intended for
+/// convolution only users, the ordered engines are unaffected.
+struct PFFFT_Convolution_Float
+{
+    explicit PFFFT_Convolution_Float(size_t n);
+
+    [[nodiscard]] auto size() const noexcept -> size_t;
+
+    auto forward(Span<float const> input, Span<float> spectrum) -> void;
+    auto backward(Span<float const> spectrum, Span<float> output) -> void;
+
+    /// Work span of 2 * size() floats, see PFFFT_Complex_Float.
+    auto forward(Span<float const> input, Span<float> spectrum, Span<float> work) -> void;
+    auto backward(Span<float const> spectrum, Span<float> output, Span<float> work) -> void;
+
+    /// ab += a * b * scale, use scale = 1/N to get a normalized backward transform. All
+    /// spectra have to be isSimdAligned, there is no work span to stage them.
+    auto convolveAccumulate(
+        Span<float const> a,
+        Span<float const> b,
+        Span<float> ab,
+        float scale
+    ) -> void;
+
+private:
+    size_t _n;
+    PFFFT_Handle _setup;
+    AlignedVector<float> _work;
 };
 
 }  // namespace mc
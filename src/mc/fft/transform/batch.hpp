@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/core/cassert.hpp>
+#include <mc/core/cstddef.hpp>
+#include <mc/core/span.hpp>
+
+namespace mc {
+
+/// Layout of count signals of a size N transform, stored in one contiguous buffer. The
+/// distances are measured in elements from the start of one signal to the next, zero
+/// means densely packed, i.e. a distance of N. With pffft, signals starting on a SIMD
+/// aligned address save a copy, see isSimdAligned.
+struct BatchLayout
+{
+    size_t size{0};
+    size_t count{0};
+    size_t inputDistance{0};
+    size_t outputDistance{0};
+};
+
+/// Calls transform(in, out) with the size N sub-spans of every signal in the batch, in
+/// order and on the calling thread.
+template<typename In, typename Out, typename Transform>
+auto forEachInBatch(
+    BatchLayout const& layout,
+    Span<In> input,
+    Span<Out> output,
+    Transform transform
+) -> void
+{
+    if (layout.count == 0) { return; }
+
+    auto const n       = layout.size;
+    auto const inDist  = layout.inputDistance == 0 ? n : layout.inputDistance;
+    auto const outDist = layout.outputDistance == 0 ? n : layout.outputDistance;
+    MC_ASSERT(inDist >= n);
+    MC_ASSERT(outDist >= n);
+    MC_ASSERT(input.size() >= (layout.count - 1) * inDist + n);
+    MC_ASSERT(output.size() >= (layout.count - 1) * outDist + n);
+
+    for (auto i = size_t{0}; i < layout.count; ++i) {
+        transform(input.subspan(i * inDist, n), output.subspan(i * outDist, n));
+    }
+}
+
+}  // namespace mc
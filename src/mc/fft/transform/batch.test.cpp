@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft: rfftMany", "[dsp][fft]")
+{
+    // Small batches run on the caller, large ones are split into blocks across threads
+    auto const threads = GENERATE(size_t{1}, size_t{3});
+    auto const count   = GENERATE(size_t{5}, size_t{400});
+    auto const size    = size_t{128};
+    auto const layout  = BatchLayout{size, count, size + 16, 0};
+
+    auto const input = generateRandomTestData(layout.count * layout.inputDistance);
+    auto spectra     = Vector<Complex<float>>(layout.count * size);
+    auto output      = Vector<float>(input.size());
+
+    auto engine = BatchRFFT<float>{size, threads};
+    REQUIRE(engine.threads() == threads);
+    rfftMany(engine, input, spectra, layout);
+
+    auto const inverse = BatchLayout{size, layout.count, 0, layout.inputDistance};
+    irfftMany(engine, spectra, output, inverse);
+
+    auto reference = makeRFFT(size);
+    auto expected  = Vector<Complex<float>>(size);
+    for (auto i = size_t{0}; i < layout.count; ++i) {
+        auto const in = Span<float const>{input}.subspan(i * layout.inputDistance, size);
+        rfft(reference, in, expected);
+        REQUIRE(ranges::equal(Span{spectra}.subspan(i * size, size), expected));
+
+        auto const out = Span<float const>{output}.subspan(i * layout.inputDistance, size);
+        REQUIRE(ranges::equal(out, in, [size](auto l, auto r) {
+            return std::abs(l / static_cast<float>(size) - r) < 1e-4F;
+        }));
+    }
+}
+
+TEST_CASE("fft: fftMany", "[dsp][fft]")
+{
+    auto const threads = GENERATE(size_t{1}, size_t{2}, size_t{4});
+    auto const count   = GENERATE(size_t{3}, size_t{1000});
+    auto const size    = size_t{64};
+    auto const layout  = BatchLayout{size, count, 0, 0};
+
+    auto input = Vector<Complex<float>>(layout.count * size);
+    for (auto& x : input) { x = {generateRnd(), generateRnd()}; }
+
+    auto output   = Vector<Complex<float>>(input.size());
+    auto expected = Vector<Complex<float>>(input.size());
+
+    auto engine    = BatchFFT<float>{size, threads};
+    auto reference = makeFFT(size);
+    fftMany(engine, input, output, layout);
+    for (auto i = size_t{0}; i < layout.count; ++i) {
+        auto const in = Span<Complex<float> const>{input}.subspan(i * size, size);
+        fft(reference, in, Span{expected}.subspan(i * size, size));
+    }
+    REQUIRE(output == expected);
+
+    ifftMany(engine, expected, output, layout);
+    REQUIRE(ranges::equal(output, input, [size](auto l, auto r) {
+        return std::abs(l / static_cast<float>(size) - r) < 1e-4F;
+    }));
+}
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/transform/backend/four_step.hpp>
+#include <mc/fft/transform/batch.hpp>
+#include <mc/fft/transform/fft.hpp>
+#include <mc/fft/transform/rfft.hpp>
+#include <mc/fft/transform/thread_pool.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/complex.hpp>
+#include <mc/core/cstddef.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+/// Batches with fewer samples than this per thread are not split any further, waking a
+/// pool thread costs about as much as transforming that many samples.
+inline constexpr auto batchGrainSize = size_t{1} << 14;
+
+/// Calls transform(engines[worker], in, out) for every signal in the batch, see
+/// forEachInBatch. The signals are split into at most pool.threads() contiguous blocks
+/// of at least batchGrainSize samples, engines needs one element per pool thread.
+template<typename Engines, typename In, typename Out, typename Transform>
+auto parallelForEachInBatch(
+    ThreadPool& pool,
+    Engines& engines,
+    BatchLayout const& layout,
+    Span<In> input,
+    Span<Out> output,
+    Transform transform
+) -> void
+{
+    auto const samples = layout.count * layout.size;
+    auto const blocks  = std::clamp(samples / batchGrainSize, size_t{1}, pool.threads());
+    auto const count   = std::min(blocks, layout.count);
+    if (count == 0) { return; }
+
+    auto const inDist  = layout.inputDistance == 0 ? layout.size : layout.inputDistance;
+    auto const outDist = layout.outputDistance == 0 ? layout.size : layout.outputDistance;
+
+    pool.run(engines, count, [&](auto& engine, size_t firstBlock, size_t lastBlock) {
+        auto const first = firstBlock * layout.count / count;
+        auto const last  = lastBlock * layout.count / count;
+        auto const rows  = BatchLayout{layout.size, last - first, inDist, outDist};
+        forEachInBatch(
+            rows,
+            input.subspan(first * inDist),
+            output.subspan(first * outDist),
+            [&engine, &transform](auto in, auto out) { transform(engine, in, out); }
+        );
+    });
+}
+
+/// Complex transforms of many equally sized signals, see BatchLayout. The signals are
+/// split across threads, each with its own engine from makeFFT, which share their plans
+/// through the plan cache. The threads stay alive between calls, so small transforms
+/// don't pay for thread creation. Batches below batchGrainSize samples per thread use
+/// fewer threads, a single thread runs on the caller only.
+template<typename T = float>
+struct BatchFFT
+{
+    explicit BatchFFT(size_t size, size_t threads = fftThreads())
+        : _pool{std::max(threads, size_t{1})}
+    {
+        _engines.reserve(_pool.threads());
+        for (auto i = size_t{0}; i < _pool.threads(); ++i) {
+            _engines.push_back(makeFFT<T>(size));
+        }
+    }
+
+    [[nodiscard]] auto threads() const noexcept -> size_t { return _pool.threads(); }
+
+    auto fftMany(
+        Span<Complex<T> const> input,
+        Span<Complex<T>> output,
+        BatchLayout const& layout
+    ) -> void
+    {
+        auto transform = [](auto& engine, auto in, auto out) {
+            ::mc::fft(engine, in, out);
+        };
+        parallelForEachInBatch(_pool, _engines, layout, input, output, transform);
+    }
+
+    auto ifftMany(
+        Span<Complex<T> const> input,
+        Span<Complex<T>> output,
+        BatchLayout const& layout
+    ) -> void
+    {
+        auto transform = [](auto& engine, auto in, auto out) {
+            ::mc::ifft(engine, in, out);
+        };
+        parallelForEachInBatch(_pool, _engines, layout, input, output, transform);
+    }
+
+private:
+    Vector<FFT<T>> _engines;
+    ThreadPool _pool;
+};
+
+/// Real transforms of many equally sized signals, see BatchFFT. Every signal produces
+/// the full N-bin spectrum, like rfft.
+template<typename T = float>
+struct BatchRFFT
+{
+    explicit BatchRFFT(size_t size, size_t threads = fftThreads())
+        : _pool{std::max(threads, size_t{1})}
+    {
+        _engines.reserve(_pool.threads());
+        for (auto i = size_t{0}; i < _pool.threads(); ++i) {
+            _engines.push_back(makeRFFT<T>(size));
+        }
+    }
+
+    [[nodiscard]] auto threads() const noexcept -> size_t { return _pool.threads(); }
+
+    auto rfftMany(Span<T const> input, Span<Complex<T>> output, BatchLayout const& layout)
+        -> void
+    {
+        auto transform = [](auto& engine, auto in, auto out) {
+            ::mc::rfft(engine, in, out);
+        };
+        parallelForEachInBatch(_pool, _engines, layout, input, output, transform);
+    }
+
+    auto irfftMany(Span<Complex<T> const> input, Span<T> output, BatchLayout const& layout)
+        -> void
+    {
+        auto transform = [](auto& engine, auto in, auto out) {
+            ::mc::irfft(engine, in, out);
+        };
+        parallelForEachInBatch(_pool, _engines, layout, input, output, transform);
+    }
+
+private:
+    Vector<RFFT<T>> _engines;
+    ThreadPool _pool;
+};
+
+}  // namespace mc
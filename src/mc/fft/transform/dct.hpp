@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/transform/backend/fftw.hpp>
+
+#include <mc/core/span.hpp>
+
+namespace mc {
+
+template<typename Engine>
+auto dct(Engine& engine, Span<float const> input, Span<float> output)
+    -> decltype(engine.dct(input, output))
+{
+    return engine.dct(input, output);
+}
+
+template<typename Engine>
+auto idct(Engine& engine, Span<float const> input, Span<float> output)
+    -> decltype(engine.idct(input, output))
+{
+    return engine.idct(input, output);
+}
+
+template<typename Engine>
+auto dct(Engine& engine, Span<double const> input, Span<double> output)
+    -> decltype(engine.dct(input, output))
+{
+    return engine.dct(input, output);
+}
+
+template<typename Engine>
+auto idct(Engine& engine, Span<double const> input, Span<double> output)
+    -> decltype(engine.idct(input, output))
+{
+    return engine.idct(input, output);
+}
+
+/// Cosine transform of the given kind (TransformKind::dct2, dct3 or dct4), see FFTW_DCT
+/// for the scaling. A size N DCT-II covers the spectrum of the 2N symmetric extension
+/// of a signal without materializing the mirrored copy.
+template<typename FloatT = float>
+[[nodiscard]] auto makeDCT(size_t size, TransformKind kind) -> FFTW_DCT<FloatT>
+{
+    return FFTW_DCT<FloatT>{size, kind, fftwPlanner()};
+}
+
+}  // namespace mc
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/cmath.hpp>
+#include <mc/core/numbers.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+namespace {
+
+auto naiveDCT(Span<float const> x, TransformKind kind) -> Vector<double>
+{
+    auto const n = static_cast<double>(x.size());
+    auto y       = Vector<double>(x.size());
+    for (auto k = size_t{0}; k < x.size(); ++k) {
+        auto const kk = static_cast<double>(k);
+        for (auto j = size_t{0}; j < x.size(); ++j) {
+            auto const jj = static_cast<double>(j);
+            if (kind == TransformKind::dct2) {
+                y[k] += 2.0 * x[j] * std::cos(numbers::pi * (jj + 0.5) * kk / n);
+            } else if (kind == TransformKind::dct3) {
+                auto const w = std::cos(numbers::pi * jj * (kk + 0.5) / n);
+                y[k] += j == 0 ? x[0] : 2.0 * x[j] * w;
+            } else {
+                y[k] += 2.0 * x[j] * std::cos(numbers::pi * (jj + 0.5) * (kk + 0.5) / n);
+            }
+        }
+    }
+    return y;
+}
+
+}  // namespace
+
+TEST_CASE("fft: FFTW_DCT", "[dsp][fft]")
+{
+    auto const size = GENERATE(size_t{8}, size_t{31}, size_t{128});
+    auto const kind = GENERATE(
+        TransformKind::dct2,
+        TransformKind::dct3,
+        TransformKind::dct4
+    );
+
+    auto const input = generateRandomTestData(size);
+    auto output      = Vector<float>(size);
+    auto roundTrip   = Vector<float>(size);
+
+    auto engine = makeDCT(size, kind);
+    dct(engine, input, output);
+
+    auto const expected = naiveDCT(input, kind);
+    for (auto i = size_t{0}; i < size; ++i) {
+        REQUIRE(std::abs(output[i] - expected[i]) < 1e-3);
+    }
+
+    // Inverse kind, scaled by 2N
+    idct(engine, output, roundTrip);
+    auto const scale = 1.0F / static_cast<float>(2 * size);
+    for (auto i = size_t{0}; i < size; ++i) {
+        REQUIRE(std::abs(roundTrip[i] * scale - input[i]) < 1e-4F);
+    }
+
+    REQUIRE_THROWS_AS(FFTW_DCT_Float(size, TransformKind::real), InvalidArgument);
+}
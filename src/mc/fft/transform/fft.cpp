@@ -3,5 +3,21 @@
 #include "fft.hpp"
 
 namespace mc {
-auto makeFFT(size_t size) -> FFT<float> { return FFT<float>{PFFFT_Complex_Float{size}}; }
+
+template<>
+auto makeFFT<float>(size_t size) -> FFT<float>
+{
+    return visitFFT<float>(size, [](auto& engine) {
+        return FFT<float>{std::move(engine)};
+    });
+}
+
+template<>
+auto makeFFT<double>(size_t size) -> FFT<double>
+{
+    return visitFFT<double>(size, [](auto& engine) {
+        return FFT<double>{std::move(engine)};
+    });
+}
+
 }  // namespace mc
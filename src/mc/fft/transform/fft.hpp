@@ -4,11 +4,19 @@
 
 #include <mc/core/config.hpp>
 
+#include <mc/fft/transform/backend/bluestein.hpp>
+#include <mc/fft/transform/backend/fftw.hpp>
+#include <mc/fft/transform/backend/four_step.hpp>
 #include <mc/fft/transform/backend/pffft.hpp>
+#include <mc/fft/transform/batch.hpp>
+#include <mc/fft/transform/simd.hpp>
+#include <mc/fft/transform/small_box.hpp>
 
 #include <mc/core/algorithm.hpp>
 #include <mc/core/complex.hpp>
 #include <mc/core/memory.hpp>
+#include <mc/core/type_traits.hpp>
+#include <mc/core/utility.hpp>
 
 namespace mc {
 
@@ -28,11 +36,81 @@ ifft(Engine& engine, Span<Complex<float> const> input, Span<Complex<float>> outp
     return engine.ifft(input, output);
 }
 
+template<typename Engine>
+inline auto
+fft(Engine& engine, Span<Complex<double> const> input, Span<Complex<double>> output)
+    -> decltype(engine.fft(input, output))
+{
+    return engine.fft(input, output);
+}
+
+template<typename Engine>
+inline auto
+ifft(Engine& engine, Span<Complex<double> const> input, Span<Complex<double>> output)
+    -> decltype(engine.ifft(input, output))
+{
+    return engine.ifft(input, output);
+}
+
+/// Transforms a batch of equally sized signals, see BatchFFT.
+template<typename Engine>
+inline auto fftMany(
+    Engine& engine,
+    Span<Complex<float> const> input,
+    Span<Complex<float>> output,
+    BatchLayout const& layout
+) -> decltype(engine.fftMany(input, output, layout))
+{
+    return engine.fftMany(input, output, layout);
+}
+
+template<typename Engine>
+inline auto ifftMany(
+    Engine& engine,
+    Span<Complex<float> const> input,
+    Span<Complex<float>> output,
+    BatchLayout const& layout
+) -> decltype(engine.ifftMany(input, output, layout))
+{
+    return engine.ifftMany(input, output, layout);
+}
+
+template<typename Engine>
+inline auto fftMany(
+    Engine& engine,
+    Span<Complex<double> const> input,
+    Span<Complex<double>> output,
+    BatchLayout const& layout
+) -> decltype(engine.fftMany(input, output, layout))
+{
+    return engine.fftMany(input, output, layout);
+}
+
+template<typename Engine>
+inline auto ifftMany(
+    Engine& engine,
+    Span<Complex<double> const> input,
+    Span<Complex<double>> output,
+    BatchLayout const& layout
+) -> decltype(engine.ifftMany(input, output, layout))
+{
+    return engine.ifftMany(input, output, layout);
+}
+
+/// Type-erased engine. Engines of up to smallBufferSize bytes are stored inline, so
+/// wrapping one doesn't allocate. Hot loops should use the concrete engine, see visitFFT.
+///
+/// Input & output have no alignment requirements, for every backend. Engines which need
+/// SIMD aligned buffers copy unaligned ones through their scratch memory, AlignedVector
+/// avoids that copy.
 template<typename T>
 struct FFT
 {
+    static constexpr auto smallBufferSize = size_t{192};
+
     template<typename ImplT>
-    FFT(ImplT&& model) : _concept{makeUnique<ModelType<ImplT>>(std::forward<ImplT>(model))}
+    FFT(ImplT&& model)
+        : _concept{Box::template make<ModelType<ImplT>>(std::forward<ImplT>(model))}
     {}
 
     FFT(FFT const& other)                    = delete;
@@ -54,7 +132,8 @@ struct FFT
 private:
     struct ConceptType
     {
-        virtual ~ConceptType() = default;
+        virtual ~ConceptType()                              = default;
+        virtual auto moveTo(void* storage) -> ConceptType* = 0;
         virtual auto do_fft(Span<Complex<T> const> in, Span<Complex<T>> out) -> void  = 0;
         virtual auto do_ifft(Span<Complex<T> const> in, Span<Complex<T>> out) -> void = 0;
     };
@@ -64,7 +143,10 @@ private:
     {
         ModelType(ImplT&& m) : model{std::forward<ImplT>(m)} {}
 
-        ~ModelType() override = default;
+        auto moveTo(void* storage) -> ConceptType* override
+        {
+            return new (storage) ModelType{std::move(*this)};
+        }
 
         auto do_fft(Span<Complex<T> const> in, Span<Complex<T>> out) -> void override
         {
@@ -79,9 +161,55 @@ private:
         ImplT model;
     };
 
-    UniquePtr<ConceptType> _concept{nullptr};
+    using Box = SmallBox<ConceptType, smallBufferSize>;
+
+    Box _concept;
+
+public:
+    /// True if the engine is stored inline, without a heap allocation.
+    template<typename ImplT>
+    static constexpr auto storesInline = Box::template fitsInline<ModelType<ImplT>>;
 };
 
-[[nodiscard]] auto makeFFT(size_t size) -> FFT<float>;
+/// Calls func with the concrete engine makeFFT<T> would choose for the given size, so
+/// the caller can be instantiated on the engine type instead of going through the
+/// virtual calls of FFT<T>.
+template<typename T = float, typename Func>
+auto visitFFT(size_t size, Func&& func) -> decltype(auto)
+{
+    if constexpr (std::is_same_v<T, double>) {
+        auto engine = FFTW_Complex_Double{size, fftwPlanner()};
+        return func(engine);
+    } else {
+        if (size >= fourStepThreshold && fourStepSplit(size) != 0) {
+            auto engine = FourStep_Complex_Float{size, fftThreads()};
+            return func(engine);
+        }
+        if (auto const planner = fftwPlanner(); planner != FFTWPlanner::estimate) {
+            auto engine = FFTW_Complex_Float{size, planner};
+            return func(engine);
+        }
+
+        if (auto setup = tryMakePFFFTHandle(size, TransformKind::complex); setup) {
+            auto engine = PFFFT_Complex_Float{size, std::move(setup)};
+            return func(engine);
+        }
+        auto engine = Bluestein_Complex_Float{size};
+        return func(engine);
+    }
+}
+
+/// Single precision uses pffft, or a Bluestein transform for sizes pffft does not
+/// support. Sizes from fourStepThreshold on use the threaded FourStep_Complex_Float.
+/// Double precision uses FFTW. Planned with fftwPlanner(), which also moves single
+/// precision below fourStepThreshold to FFTW unless it is estimate.
+template<typename T = float>
+[[nodiscard]] auto makeFFT(size_t size) -> FFT<T>;
+
+template<>
+[[nodiscard]] auto makeFFT<float>(size_t size) -> FFT<float>;
+
+template<>
+[[nodiscard]] auto makeFFT<double>(size_t size) -> FFT<double>;
 
 }  // namespace mc
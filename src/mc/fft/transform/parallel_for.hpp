@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cstddef.hpp>
+#include <mc/core/thread.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+/// Splits [0, count) into one contiguous chunk per worker & calls func(worker, first,
+/// last) for every chunk. The calling thread takes the first chunk, every other chunk
+/// runs on its own thread. Returns once all chunks are done.
+template<typename Workers, typename Func>
+auto parallelFor(Workers& workers, size_t count, Func func) -> void
+{
+    auto const n = std::min(workers.size(), count);
+    if (n <= 1) {
+        func(workers[0], 0, count);
+        return;
+    }
+
+    auto const chunk = (count + n - 1) / n;
+    auto threads     = Vector<std::thread>{};
+    threads.reserve(n - 1);
+    for (auto i = size_t{1}; i < n; ++i) {
+        auto const first = std::min(count, i * chunk);
+        auto const last  = std::min(count, first + chunk);
+        threads.emplace_back([&func, &w = workers[i], first, last] {
+            func(w, first, last);
+        });
+    }
+
+    func(workers[0], 0, chunk);
+    for (auto& thread : threads) { thread.join(); }
+}
+
+}  // namespace mc
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "plan_cache.hpp"
+
+#include <mc/fft/transform/backend/bluestein.hpp>
+#include <mc/fft/transform/backend/fftw.hpp>
+#include <mc/fft/transform/backend/pffft.hpp>
+
+namespace mc {
+
+auto fftPlanCacheStats() -> PlanCacheStats
+{
+    auto total = PlanCacheStats{};
+    for (auto const& stats : {
+             pffftPlanCache().stats(),
+             bluesteinPlanCache().stats(),
+             fftwPlanCache<float>().stats(),
+             fftwPlanCache<double>().stats(),
+         }) {
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.plans += stats.plans;
+    }
+    return total;
+}
+
+auto clearFFTPlanCaches() -> void
+{
+    pffftPlanCache().clear();
+    bluesteinPlanCache().clear();
+    fftwPlanCache<float>().clear();
+    fftwPlanCache<double>().clear();
+}
+
+}  // namespace mc
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/core/cstddef.hpp>
+#include <mc/core/map.hpp>
+#include <mc/core/memory.hpp>
+#include <mc/core/mutex.hpp>
+#include <mc/core/tuple.hpp>
+#include <mc/core/utility.hpp>
+
+namespace mc {
+
+enum struct TransformKind
+{
+    complex,
+    real,
+
+    /// Real-to-real cosine transforms, see FFTW_DCT.
+    dct2,
+    dct3,
+    dct4,
+};
+
+enum struct TransformPrecision
+{
+    float32,
+    float64,
+};
+
+template<typename FloatT>
+inline constexpr auto transformPrecision
+    = sizeof(FloatT) == sizeof(float) ? TransformPrecision::float32
+                                      : TransformPrecision::float64;
+
+struct PlanKey
+{
+    size_t size{0};
+    TransformKind kind{TransformKind::complex};
+    TransformPrecision precision{TransformPrecision::float32};
+
+    /// Backend specific planning options, e.g. the FFTW planner rigor.
+    unsigned flags{0};
+
+    friend auto operator<(PlanKey const& lhs, PlanKey const& rhs) -> bool
+    {
+        return std::tie(lhs.size, lhs.kind, lhs.precision, lhs.flags)
+             < std::tie(rhs.size, rhs.kind, rhs.precision, rhs.flags);
+    }
+};
+
+template<typename FloatT>
+[[nodiscard]] constexpr auto makePlanKey(size_t size, TransformKind kind) -> PlanKey
+{
+    return PlanKey{size, kind, transformPrecision<FloatT>, 0U};
+}
+
+struct PlanCacheStats
+{
+    size_t hits{0};
+    size_t misses{0};
+    size_t plans{0};
+};
+
+/// Thread-safe registry of immutable transform plans. A plan is created once per key and
+/// shared by every engine asking for the same size, kind & precision. Engines keep their
+/// own scratch memory, so a shared plan can be executed from multiple threads at once.
+template<typename PlanT>
+struct PlanCache
+{
+    PlanCache() = default;
+
+    PlanCache(PlanCache const& other)                    = delete;
+    auto operator=(PlanCache const& other) -> PlanCache& = delete;
+
+    /// Returns the cached plan for key or creates it by calling factory. The factory must
+    /// return a SharedPtr<PlanT>. A nullptr result, e.g. a size the backend rejects, is
+    /// cached as well, so the factory isn't called again for that key.
+    ///
+    /// The factory runs without holding the cache lock, so a slow plan (e.g. FFTW_PATIENT)
+    /// doesn't block hits on other keys. Threads missing the same key at the same time
+    /// may each create a plan, the first one inserted is returned to all of them.
+    template<typename Factory>
+    [[nodiscard]] auto get(PlanKey const& key, Factory&& factory) -> SharedPtr<PlanT>
+    {
+        {
+            auto const lock = std::scoped_lock{_mutex};
+            if (auto found = _plans.find(key); found != _plans.end()) {
+                ++_hits;
+                return found->second;
+            }
+            ++_misses;
+        }
+
+        auto plan = SharedPtr<PlanT>{std::forward<Factory>(factory)()};
+
+        auto const lock           = std::scoped_lock{_mutex};
+        auto const [it, inserted] = _plans.emplace(key, std::move(plan));
+        if (inserted && it->second == nullptr) { ++_rejected; }
+        return it->second;
+    }
+
+    /// plans only counts real plans, not the cached nullptr results.
+    [[nodiscard]] auto stats() const -> PlanCacheStats
+    {
+        auto const lock = std::scoped_lock{_mutex};
+        return PlanCacheStats{_hits, _misses, _plans.size() - _rejected};
+    }
+
+    /// Drops all plans and resets the counters. Engines which are still alive keep their
+    /// plans until they are destroyed.
+    auto clear() -> void
+    {
+        auto const lock = std::scoped_lock{_mutex};
+        _plans.clear();
+        _hits     = 0;
+        _misses   = 0;
+        _rejected = 0;
+    }
+
+private:
+    mutable std::mutex _mutex;
+    Map<PlanKey, SharedPtr<PlanT>> _plans;
+    size_t _hits{0};
+    size_t _misses{0};
+    size_t _rejected{0};
+};
+
+/// Accumulated hit/miss counters of all backend plan caches.
+[[nodiscard]] auto fftPlanCacheStats() -> PlanCacheStats;
+
+/// Clears the plan caches of all backends.
+auto clearFFTPlanCaches() -> void;
+
+}  // namespace mc
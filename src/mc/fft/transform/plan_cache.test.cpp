@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/thread.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft: PlanCache", "[dsp][fft]")
+{
+    auto cache = PlanCache<int>{};
+    auto calls = 0;
+    auto make  = [&calls] {
+        ++calls;
+        return makeShared<int>(42);
+    };
+
+    auto const a = cache.get(makePlanKey<float>(64, TransformKind::real), make);
+    auto const b = cache.get(makePlanKey<float>(64, TransformKind::real), make);
+    auto const c = cache.get(makePlanKey<float>(64, TransformKind::complex), make);
+    auto const d = cache.get(makePlanKey<double>(64, TransformKind::real), make);
+
+    REQUIRE(calls == 3);
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+    REQUIRE(a != d);
+
+    auto const stats = cache.stats();
+    REQUIRE(stats.hits == 1U);
+    REQUIRE(stats.misses == 3U);
+    REQUIRE(stats.plans == 3U);
+
+    auto const e = cache.get(makePlanKey<float>(32, TransformKind::real), [] {
+        return SharedPtr<int>{};
+    });
+    REQUIRE(e == nullptr);
+    REQUIRE(cache.stats().plans == 3U);
+
+    // The rejected key is cached, the factory isn't called again
+    auto const f = cache.get(makePlanKey<float>(32, TransformKind::real), make);
+    REQUIRE(f == nullptr);
+    REQUIRE(calls == 3);
+    REQUIRE(cache.stats().hits == 2U);
+    REQUIRE(cache.stats().misses == 4U);
+
+    cache.clear();
+    REQUIRE(cache.stats().hits == 0U);
+    REQUIRE(cache.stats().plans == 0U);
+}
+
+TEST_CASE("fft: PlanCache(concurrent miss)", "[dsp][fft]")
+{
+    auto cache      = PlanCache<int>{};
+    auto const hit  = makePlanKey<float>(64, TransformKind::real);
+    auto const miss = makePlanKey<float>(128, TransformKind::real);
+    (void)cache.get(hit, [] { return makeShared<int>(1); });
+
+    // The factory runs outside of the lock. Other keys are served meanwhile and a plan
+    // inserted for the same key in the meantime wins over the one being created.
+    auto const plan = cache.get(miss, [&cache, hit, miss] {
+        REQUIRE(*cache.get(hit, [] { return makeShared<int>(0); }) == 1);
+        REQUIRE(*cache.get(miss, [] { return makeShared<int>(2); }) == 2);
+        return makeShared<int>(3);
+    });
+
+    REQUIRE(*plan == 2);
+    REQUIRE(*cache.get(miss, [] { return makeShared<int>(4); }) == 2);
+    REQUIRE(cache.stats().plans == 2U);
+}
+
+TEST_CASE("fft: PlanCache(rejected size)", "[dsp][fft]")
+{
+    clearFFTPlanCaches();
+
+    // Neither pffft transform supports an odd prime size, the fallback reaches a steady
+    // state after the first engine
+    auto const size = size_t{67};
+    (void)makeRFFT(size);
+    auto const first = fftPlanCacheStats();
+    for (auto i{0}; i < 4; ++i) { (void)makeRFFT(size); }
+    auto const steady = fftPlanCacheStats();
+
+    REQUIRE(steady.misses == first.misses);
+    REQUIRE(steady.plans == first.plans);
+    REQUIRE(steady.hits > first.hits);
+}
+
+TEST_CASE("fft: PlanCache(makeRFFT)", "[dsp][fft]")
+{
+    clearFFTPlanCaches();
+
+    auto const input = generateRandomTestData(256);
+    auto expected    = Vector<Complex<float>>(input.size());
+    auto engine      = makeRFFT(input.size());
+    rfft(engine, input, expected);
+
+    auto threads = Vector<std::thread>{};
+    auto results = Vector<Vector<Complex<float>>>(8);
+    for (auto& result : results) {
+        threads.emplace_back([&input, &result] {
+            auto fft = makeRFFT(input.size());
+            result.resize(input.size());
+            for (auto i{0}; i < 16; ++i) { rfft(fft, input, result); }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    for (auto const& result : results) { REQUIRE(result == expected); }
+
+    auto const stats = fftPlanCacheStats();
+    REQUIRE(stats.misses == 1U);
+    REQUIRE(stats.hits == results.size());
+}
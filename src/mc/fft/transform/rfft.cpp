@@ -3,5 +3,21 @@
 #include "rfft.hpp"
 
 namespace mc {
-auto makeRFFT(size_t size) -> RFFT<float> { return RFFT<float>{PFFFT_Real_Float{size}}; }
+
+template<>
+auto makeRFFT<float>(size_t size) -> RFFT<float>
+{
+    return visitRFFT<float>(size, [](auto& engine) {
+        return RFFT<float>{std::move(engine)};
+    });
+}
+
+template<>
+auto makeRFFT<double>(size_t size) -> RFFT<double>
+{
+    return visitRFFT<double>(size, [](auto& engine) {
+        return RFFT<double>{std::move(engine)};
+    });
+}
+
 }  // namespace mc
@@ -9,6 +9,8 @@
 #include <mc/core/complex.hpp>
 #include <mc/core/memory.hpp>
 #include <mc/core/span.hpp>
+#include <mc/core/type_traits.hpp>
+#include <mc/core/utility.hpp>
 
 #include <pffft.h>
 
@@ -42,11 +44,98 @@ auto irfft(Engine& engine, Span<Complex<double> const> input, Span<double> outpu
     return engine.irfft(input, output);
 }
 
+/// Number of non-redundant bins in the spectrum of a size n real transform, used by the
+/// 2D & short-time transforms.
+[[nodiscard]] constexpr auto halfSpectrumSize(size_t n) -> size_t { return n / 2 + 1; }
+
+/// Number of bins in the packed real spectrum of a size n transform.
+[[nodiscard]] constexpr auto packedSpectrumSize(size_t n) -> size_t { return n / 2; }
+
+/// Packed real spectrum, see packedSpectrumSize. Bins 1..N/2-1 are stored as usual, the
+/// purely real DC & Nyquist bins share slot 0 as {DC, Nyquist}. Unlike rfft this skips
+/// filling the conjugate upper half, irfftPacked reads its input without a copy.
+template<typename Engine>
+auto rfftPacked(Engine& engine, Span<float const> input, Span<Complex<float>> output)
+    -> decltype(engine.rfftPacked(input, output))
+{
+    return engine.rfftPacked(input, output);
+}
+
+template<typename Engine>
+auto irfftPacked(Engine& engine, Span<Complex<float> const> input, Span<float> output)
+    -> decltype(engine.irfftPacked(input, output))
+{
+    return engine.irfftPacked(input, output);
+}
+
+template<typename Engine>
+auto rfftPacked(Engine& engine, Span<double const> input, Span<Complex<double>> output)
+    -> decltype(engine.rfftPacked(input, output))
+{
+    return engine.rfftPacked(input, output);
+}
+
+template<typename Engine>
+auto irfftPacked(Engine& engine, Span<Complex<double> const> input, Span<double> output)
+    -> decltype(engine.irfftPacked(input, output))
+{
+    return engine.irfftPacked(input, output);
+}
+
+/// Batched rfft, see BatchRFFT. Every signal produces the full N-bin spectrum.
+template<typename Engine>
+auto rfftMany(
+    Engine& engine,
+    Span<float const> input,
+    Span<Complex<float>> output,
+    BatchLayout const& layout
+) -> decltype(engine.rfftMany(input, output, layout))
+{
+    return engine.rfftMany(input, output, layout);
+}
+
+template<typename Engine>
+auto irfftMany(
+    Engine& engine,
+    Span<Complex<float> const> input,
+    Span<float> output,
+    BatchLayout const& layout
+) -> decltype(engine.irfftMany(input, output, layout))
+{
+    return engine.irfftMany(input, output, layout);
+}
+
+template<typename Engine>
+auto rfftMany(
+    Engine& engine,
+    Span<double const> input,
+    Span<Complex<double>> output,
+    BatchLayout const& layout
+) -> decltype(engine.rfftMany(input, output, layout))
+{
+    return engine.rfftMany(input, output, layout);
+}
+
+template<typename Engine>
+auto irfftMany(
+    Engine& engine,
+    Span<Complex<double> const> input,
+    Span<double> output,
+    BatchLayout const& layout
+) -> decltype(engine.irfftMany(input, output, layout))
+{
+    return engine.irfftMany(input, output, layout);
+}
+
+/// Type-erased engine, see FFT, including its alignment rules. Hot loops should use the
+/// concrete engine, see visitRFFT.
 template<typename FloatT>
 struct RFFT
 {
+    static constexpr auto smallBufferSize = size_t{192};
+
     template<typename T>
-    RFFT(T&& model) : _concept{makeUnique<ModelType<T>>(std::forward<T>(model))}
+    RFFT(T&& model) : _concept{Box::template make<ModelType<T>>(std::forward<T>(model))}
     {}
 
     RFFT(RFFT const& other)                    = delete;
@@ -65,12 +154,29 @@ struct RFFT
         _concept->do_irfft(input, output);
     }
 
+    auto rfftPacked(Span<FloatT const> input, Span<Complex<FloatT>> output)
+    {
+        _concept->do_rfftPacked(input, output);
+    }
+
+    auto irfftPacked(Span<Complex<FloatT> const> input, Span<FloatT> output)
+    {
+        _concept->do_irfftPacked(input, output);
+    }
+
 private:
     struct ConceptType
     {
-        virtual ~ConceptType() = default;
+        virtual ~ConceptType()                              = default;
+        virtual auto moveTo(void* storage) -> ConceptType* = 0;
         virtual auto do_rfft(Span<FloatT const> in, Span<Complex<FloatT>> out) -> void  = 0;
         virtual auto do_irfft(Span<Complex<FloatT> const> in, Span<FloatT> out) -> void = 0;
+        virtual auto do_rfftPacked(Span<FloatT const> in, Span<Complex<FloatT>> out)
+            -> void
+            = 0;
+        virtual auto do_irfftPacked(Span<Complex<FloatT> const> in, Span<FloatT> out)
+            -> void
+            = 0;
     };
 
     template<typename T>
@@ -78,7 +184,10 @@ private:
     {
         ModelType(T&& m) : model{std::forward<T>(m)} {}
 
-        ~ModelType() override = default;
+        auto moveTo(void* storage) -> ConceptType* override
+        {
+            return new (storage) ModelType{std::move(*this)};
+        }
 
         auto do_rfft(Span<FloatT const> input, Span<Complex<FloatT>> output)
             -> void override
@@ -92,12 +201,67 @@ private:
             ::mc::irfft(model, input, output);
         }
 
+        auto do_rfftPacked(Span<FloatT const> input, Span<Complex<FloatT>> output)
+            -> void override
+        {
+            ::mc::rfftPacked(model, input, output);
+        }
+
+        auto do_irfftPacked(Span<Complex<FloatT> const> input, Span<FloatT> output)
+            -> void override
+        {
+            ::mc::irfftPacked(model, input, output);
+        }
+
         T model;
     };
 
-    UniquePtr<ConceptType> _concept{nullptr};
+    using Box = SmallBox<ConceptType, smallBufferSize>;
+
+    Box _concept;
+
+public:
+    /// True if the engine is stored inline, without a heap allocation.
+    template<typename T>
+    static constexpr auto storesInline = Box::template fitsInline<ModelType<T>>;
 };
 
-[[nodiscard]] auto makeRFFT(size_t size) -> RFFT<float>;
+/// Calls func with the concrete engine makeRFFT<FloatT> would choose, see visitFFT.
+template<typename FloatT = float, typename Func>
+auto visitRFFT(size_t size, Func&& func) -> decltype(auto)
+{
+    if constexpr (std::is_same_v<FloatT, double>) {
+        auto engine = FFTW_Real_Double{size, fftwPlanner()};
+        return func(engine);
+    } else {
+        if (auto const planner = fftwPlanner(); planner != FFTWPlanner::estimate) {
+            auto engine = FFTW_Real_Float{size, planner};
+            return func(engine);
+        }
+        if (auto setup = tryMakePFFFTHandle(size, TransformKind::real); setup) {
+            auto engine = PFFFT_Real_Float{size, std::move(setup)};
+            return func(engine);
+        }
+        if (auto setup = tryMakePFFFTHandle(size, TransformKind::complex); setup) {
+            auto engine = PFFFT_Real_Via_Complex_Float{size, std::move(setup)};
+            return func(engine);
+        }
+        auto engine = Bluestein_Real_Float{size};
+        return func(engine);
+    }
+}
+
+/// Single precision uses pffft's real transform, pffft's complex transform for sizes
+/// only the complex one supports, or a Bluestein transform for all other sizes. Double
+/// precision uses FFTW. Planned with fftwPlanner(), which also moves single precision
+/// to FFTW unless it is estimate.
+template<typename FloatT = float>
+[[nodiscard]] auto makeRFFT(size_t size) -> RFFT<FloatT>;
+
+template<>
+[[nodiscard]] auto makeRFFT<float>(size_t size) -> RFFT<float>;
+
+template<>
+[[nodiscard]] auto makeRFFT<double>(size_t size) -> RFFT<double>;
 
 }  // namespace mc
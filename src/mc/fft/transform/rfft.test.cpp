@@ -2,9 +2,11 @@
 
 #include <mc/core/iterator.hpp>
 #include <mc/fft.hpp>
+#include <mc/fft/algorithm/spectral_convolution.hpp>
 #include <mc/testing/test.hpp>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 
 using namespace mc;
 
@@ -48,3 +50,120 @@ TEST_CASE("fft: rfft", "[dsp][fft]")
         REQUIRE(ranges::equal(output, testCase.expected, closeEnough));
     }
 }
+
+template<typename Engine>
+auto testPackedRoundTrip(Engine engine, size_t size) -> void
+{
+    auto const input = generateRandomTestData(size);
+    auto full        = Vector<Complex<float>>(size);
+    auto packed      = Vector<Complex<float>>(packedSpectrumSize(size));
+    rfft(engine, input, full);
+    rfftPacked(engine, input, packed);
+
+    auto closeEnough = [](auto l, auto r) { return std::abs(l - r) < 1e-3F; };
+    REQUIRE(closeEnough(packed[0], Complex<float>{full[0].real(), full[size / 2].real()}));
+    auto const bins = Span{full}.subspan(1, size / 2 - 1);
+    REQUIRE(ranges::equal(Span{packed}.subspan(1), bins, closeEnough));
+
+    auto output = Vector<float>(size);
+    irfftPacked(engine, packed, output);
+    for (auto& x : output) { x /= static_cast<float>(size); }
+    REQUIRE(ranges::equal(output, input, closeEnough));
+}
+
+TEST_CASE("fft: rfftPacked", "[dsp][fft]")
+{
+    auto const size = GENERATE(size_t{64}, size_t{512});
+    testPackedRoundTrip(makeRFFT(size), size);
+    testPackedRoundTrip(RFFT<float>{FFTW_Real_Float{size}}, size);
+}
+
+TEST_CASE("fft: PFFFT_Real_Via_Complex_Float", "[dsp][fft]")
+{
+    // Sizes pffft's complex transform supports, but its real transform does not, e.g. 48
+    // & 80 with SSE
+    auto const simd = static_cast<size_t>(pffft_simd_size());
+    auto const size = simd * simd * GENERATE(size_t{3}, size_t{5});
+    REQUIRE(tryMakePFFFTHandle(size, TransformKind::real) == nullptr);
+
+    visitRFFT(size, [](auto& engine) {
+        using Engine = std::decay_t<decltype(engine)>;
+        REQUIRE(std::is_same_v<Engine, PFFFT_Real_Via_Complex_Float>);
+    });
+
+    auto const input = generateRandomTestData(size);
+    auto expected    = Vector<Complex<float>>(size);
+    auto output      = Vector<Complex<float>>(size);
+    auto reference   = FFTW_Real_Float{size};
+    auto engine      = PFFFT_Real_Via_Complex_Float{size};
+    rfft(reference, input, expected);
+    rfft(engine, input, output);
+
+    auto closeEnough = [](auto l, auto r) { return std::abs(l - r) < 1e-3F; };
+    REQUIRE(ranges::equal(output, expected, closeEnough));
+
+    auto roundTrip = Vector<float>(size);
+    irfft(engine, output, roundTrip);
+    for (auto& x : roundTrip) { x /= static_cast<float>(size); }
+    REQUIRE(ranges::equal(roundTrip, input, closeEnough));
+
+    if (size % 2 == 0) { testPackedRoundTrip(std::move(engine), size); }
+}
+
+TEST_CASE("fft: PFFFT_Convolution_Float", "[dsp][fft]")
+{
+    auto const size = size_t{256};
+    auto const a    = generateRandomTestData(size);
+    auto const b    = generateRandomTestData(size);
+
+    // Circular convolution through the ordered, packed API
+    auto engine   = makeRFFT(size);
+    auto aPacked  = Vector<Complex<float>>(packedSpectrumSize(size));
+    auto bPacked  = Vector<Complex<float>>(packedSpectrumSize(size));
+    auto expected = Vector<float>(size);
+    rfftPacked(engine, a, aPacked);
+    rfftPacked(engine, b, bPacked);
+    spectralConvolutionPacked(aPacked, bPacked, aPacked);
+    irfftPacked(engine, aPacked, expected);
+    for (auto& x : expected) { x /= static_cast<float>(size); }
+
+    auto convolver = PFFFT_Convolution_Float{size};
+    auto aSpectrum = Vector<float>(size);
+    auto bSpectrum = Vector<float>(size);
+    auto product   = Vector<float>(size, 0.0F);
+    auto output    = Vector<float>(size);
+    convolver.forward(a, aSpectrum);
+    convolver.forward(b, bSpectrum);
+    auto const scale = 1.0F / static_cast<float>(size);
+    convolver.convolveAccumulate(aSpectrum, bSpectrum, product, scale);
+    convolver.backward(product, output);
+
+    REQUIRE(ranges::equal(output, expected, [](auto l, auto r) {
+        return std::abs(l - r) < 1e-4F;
+    }));
+}
+
+TEST_CASE("fft: pffftFastSize", "[dsp][fft]")
+{
+    auto const isSmooth = [](size_t n) {
+        for (auto const p : {size_t{2}, size_t{3}, size_t{5}}) {
+            while (n % p == 0) { n /= p; }
+        }
+        return n == 1;
+    };
+
+    auto const kind = GENERATE(TransformKind::real, TransformKind::complex);
+    auto last       = size_t{0};
+    for (auto n = size_t{1}; n <= 5000; ++n) {
+        auto const size = pffftFastSize(n, kind);
+        REQUIRE(size >= n);
+        REQUIRE(isSmooth(size));
+        REQUIRE(size >= last);
+        if (size != last) { REQUIRE(tryMakePFFFTHandle(size, kind) != nullptr); }
+        last = size;
+    }
+
+    // Just above a power of two the padding stays well below 2x
+    CHECK(pffftFastSize(1025, TransformKind::real) < 2048);
+    CHECK(pffftFastSize(4097, TransformKind::complex) < 8192);
+}
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "rfft2d.hpp"
+
+#include <mc/fft/transform/parallel_for.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/iterator.hpp>
+#include <mc/core/stdexcept.hpp>
+
+namespace mc {
+
+namespace {
+
+// Columns per tile. A tile row is 128 bytes, two cache lines.
+constexpr auto tileSize = size_t{16};
+
+}  // namespace
+
+RFFT2D_Float::Worker::Worker(size_t rows, size_t cols, size_t stride)
+    : rowEngine{makeRFFT(cols)}
+    , colEngine{makeFFT(rows)}
+    , real(cols)
+    , row(cols)
+    , tileIn(tileSize * stride)
+    , tileOut(tileSize * stride)
+{}
+
+RFFT2D_Float::RFFT2D_Float(size_t rows, size_t cols, size_t threads)
+    : _rows{rows}
+    , _cols{cols}
+    , _bins{halfSpectrumSize(cols)}
+    , _stride{(rows + 7U) / 8U * 8U}  // Every column in a tile starts 64 byte aligned
+    , _spectrum(rows * _bins)
+{
+    if (rows == 0 || cols == 0) {
+        raise<InvalidArgument>("rfft2d: size must be greater than zero");
+    }
+    if (threads == 0) {
+        raise<InvalidArgument>("rfft2d: threads must be greater than zero");
+    }
+
+    _workers.reserve(threads);
+    for (auto i = size_t{0}; i < threads; ++i) {
+        _workers.emplace_back(rows, cols, _stride);
+    }
+}
+
+auto RFFT2D_Float::rows() const noexcept -> size_t { return _rows; }
+
+auto RFFT2D_Float::cols() const noexcept -> size_t { return _cols; }
+
+auto RFFT2D_Float::threads() const noexcept -> size_t { return _workers.size(); }
+
+auto RFFT2D_Float::rfft2d(Span<float const> input, Span<Complex<float>> output) -> void
+{
+    MC_ASSERT(input.size() >= _rows * _cols);
+    MC_ASSERT(output.size() >= _rows * _bins);
+
+    auto rows = [this, input, output](Worker& w, size_t first, size_t last) {
+        for (auto r = first; r < last; ++r) {
+            auto const in = input.subspan(r * _cols, _cols);
+            forwardRow(w, in, output.subspan(r * _bins, _bins));
+        }
+    };
+    parallelFor(_workers, _rows, rows);
+
+    parallelFor(_workers, _bins, [this, output](Worker& w, size_t first, size_t last) {
+        columns(w, output, first, last, false);
+    });
+}
+
+auto RFFT2D_Float::irfft2d(Span<Complex<float> const> input, Span<float> output) -> void
+{
+    MC_ASSERT(input.size() >= _rows * _bins);
+    MC_ASSERT(output.size() >= _rows * _cols);
+
+    auto const size = static_cast<ptrdiff_t>(_spectrum.size());
+    std::copy(input.begin(), std::next(input.begin(), size), _spectrum.begin());
+
+    auto spectrum = Span<Complex<float>>{_spectrum};
+    parallelFor(_workers, _bins, [this, spectrum](Worker& w, size_t first, size_t last) {
+        columns(w, spectrum, first, last, true);
+    });
+
+    auto rows = [this, spectrum, output](Worker& w, size_t first, size_t last) {
+        for (auto r = first; r < last; ++r) {
+            auto const in = spectrum.subspan(r * _bins, _bins);
+            backwardRow(w, in, output.subspan(r * _cols, _cols));
+        }
+    };
+    parallelFor(_workers, _rows, rows);
+}
+
+auto RFFT2D_Float::forwardRow(Worker& w, Span<float const> in, Span<Complex<float>> out)
+    -> void
+{
+    // Copied, so rows of any width hit the engine SIMD aligned.
+    std::copy(in.begin(), in.end(), w.real.begin());
+
+    if (_cols % 2 == 1) {
+        rfft(w.rowEngine, w.real, w.row);
+        auto const bins = static_cast<ptrdiff_t>(_bins);
+        std::copy(w.row.begin(), std::next(w.row.begin(), bins), out.begin());
+        return;
+    }
+
+    auto const h      = _cols / 2;
+    auto const packed = Span<Complex<float>>{w.row}.first(h);
+    rfftPacked(w.rowEngine, w.real, packed);
+    std::copy(std::next(packed.begin()), packed.end(), std::next(out.begin()));
+    out[0] = {packed[0].real(), 0.0F};
+    out[h] = {packed[0].imag(), 0.0F};
+}
+
+auto RFFT2D_Float::backwardRow(Worker& w, Span<Complex<float> const> in, Span<float> out)
+    -> void
+{
+    if (_cols % 2 == 1) {
+        irfft(w.rowEngine, in, w.real);
+    } else {
+        auto const h      = _cols / 2;
+        auto const packed = Span<Complex<float>>{w.row}.first(h);
+        auto const last   = std::next(in.begin(), static_cast<ptrdiff_t>(h));
+        std::copy(std::next(in.begin()), last, std::next(packed.begin()));
+        packed[0] = {in[0].real(), in[h].real()};
+        irfftPacked(w.rowEngine, packed, w.real);
+    }
+
+    std::copy(w.real.begin(), w.real.end(), out.begin());
+}
+
+auto RFFT2D_Float::columns(
+    Worker& w,
+    Span<Complex<float>> spectrum,
+    size_t first,
+    size_t last,
+    bool inverse
+) -> void
+{
+    for (auto c0 = first; c0 < last; c0 += tileSize) {
+        auto const width = std::min(tileSize, last - c0);
+
+        // Transpose the tile, every column becomes a contiguous signal
+        for (auto r = size_t{0}; r < _rows; ++r) {
+            auto const* src = &spectrum[r * _bins + c0];
+            for (auto j = size_t{0}; j < width; ++j) { w.tileIn[j * _stride + r] = src[j]; }
+        }
+
+        auto const layout = BatchLayout{_rows, width, _stride, _stride};
+        forEachInBatch(layout, Span{w.tileIn}, Span{w.tileOut}, [&](auto in, auto out) {
+            if (inverse) {
+                ::mc::ifft(w.colEngine, in, out);
+            } else {
+                ::mc::fft(w.colEngine, in, out);
+            }
+        });
+
+        for (auto r = size_t{0}; r < _rows; ++r) {
+            auto* dest = &spectrum[r * _bins + c0];
+            for (auto j = size_t{0}; j < width; ++j) {
+                dest[j] = w.tileOut[j * _stride + r];
+            }
+        }
+    }
+}
+
+}  // namespace mc
@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/transform/aligned_allocator.hpp>
+#include <mc/fft/transform/fft.hpp>
+#include <mc/fft/transform/rfft.hpp>
+
+#include <mc/core/complex.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+template<typename Engine>
+auto rfft2d(Engine& engine, Span<float const> input, Span<Complex<float>> output)
+    -> decltype(engine.rfft2d(input, output))
+{
+    return engine.rfft2d(input, output);
+}
+
+template<typename Engine>
+auto irfft2d(Engine& engine, Span<Complex<float> const> input, Span<float> output)
+    -> decltype(engine.irfft2d(input, output))
+{
+    return engine.irfft2d(input, output);
+}
+
+/// 2D real transform of a row-major rows x cols image. The spectrum is stored row-major
+/// as rows x halfSpectrumSize(cols) bins, the conjugate symmetric half is skipped. Like
+/// the 1D engines the inverse is unnormalized, divide by rows * cols.
+///
+/// Rows are transformed one by one. Columns are gathered in tiles into contiguous
+/// scratch, transformed as a batch & scattered back, so no pass walks memory with a
+/// stride of a full row. With threads > 1 both passes are split across worker threads,
+/// each worker owns its engines & scratch.
+struct RFFT2D_Float
+{
+    RFFT2D_Float(size_t rows, size_t cols, size_t threads = 1);
+
+    [[nodiscard]] auto rows() const noexcept -> size_t;
+    [[nodiscard]] auto cols() const noexcept -> size_t;
+    [[nodiscard]] auto threads() const noexcept -> size_t;
+
+    auto rfft2d(Span<float const> input, Span<Complex<float>> output) -> void;
+    auto irfft2d(Span<Complex<float> const> input, Span<float> output) -> void;
+
+private:
+    struct Worker
+    {
+        Worker(size_t rows, size_t cols, size_t stride);
+
+        RFFT<float> rowEngine;
+        FFT<float> colEngine;
+        AlignedVector<float> real;
+        AlignedVector<Complex<float>> row;
+        AlignedVector<Complex<float>> tileIn;
+        AlignedVector<Complex<float>> tileOut;
+    };
+
+    auto forwardRow(Worker& w, Span<float const> in, Span<Complex<float>> out) -> void;
+    auto backwardRow(Worker& w, Span<Complex<float> const> in, Span<float> out) -> void;
+    auto columns(
+        Worker& w,
+        Span<Complex<float>> spectrum,
+        size_t first,
+        size_t last,
+        bool inverse
+    ) -> void;
+
+    size_t _rows;
+    size_t _cols;
+    size_t _bins;
+    size_t _stride;
+    Vector<Worker> _workers;
+    AlignedVector<Complex<float>> _spectrum;
+};
+
+}  // namespace mc
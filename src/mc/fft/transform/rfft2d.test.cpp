@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/cmath.hpp>
+#include <mc/core/numbers.hpp>
+#include <mc/core/tuple.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+namespace {
+
+auto naiveRFFT2D(Span<float const> input, size_t rows, size_t cols)
+    -> Vector<Complex<double>>
+{
+    auto const bins = halfSpectrumSize(cols);
+    auto output     = Vector<Complex<double>>(rows * bins);
+    for (auto u = size_t{0}; u < rows; ++u) {
+        for (auto v = size_t{0}; v < bins; ++v) {
+            auto sum = Complex<double>{};
+            for (auto r = size_t{0}; r < rows; ++r) {
+                for (auto c = size_t{0}; c < cols; ++c) {
+                    auto const phase = -2.0 * numbers::pi
+                                     * (double(u * r) / double(rows)
+                                        + double(v * c) / double(cols));
+                    sum += double(input[r * cols + c]) * std::polar(1.0, phase);
+                }
+            }
+            output[u * bins + v] = sum;
+        }
+    }
+    return output;
+}
+
+}  // namespace
+
+TEST_CASE("fft: RFFT2D_Float", "[dsp][fft]")
+{
+    auto const [rows, cols, threads] = GENERATE(
+        std::tuple{size_t{32}, size_t{64}, size_t{1}},
+        std::tuple{size_t{48}, size_t{33}, size_t{1}},
+        std::tuple{size_t{20}, size_t{128}, size_t{3}},
+        std::tuple{size_t{3}, size_t{32}, size_t{8}}
+    );
+
+    auto const input = generateRandomTestData(rows * cols);
+    auto spectrum    = Vector<Complex<float>>(rows * halfSpectrumSize(cols));
+    auto output      = Vector<float>(rows * cols);
+
+    auto engine = RFFT2D_Float{rows, cols, threads};
+    rfft2d(engine, input, spectrum);
+
+    auto const expected = naiveRFFT2D(input, rows, cols);
+    for (auto i = size_t{0}; i < expected.size(); ++i) {
+        REQUIRE(std::abs(Complex<double>(spectrum[i]) - expected[i]) < 1e-2);
+    }
+
+    irfft2d(engine, spectrum, output);
+    auto const scale = 1.0F / static_cast<float>(rows * cols);
+    for (auto i = size_t{0}; i < output.size(); ++i) {
+        REQUIRE(std::abs(output[i] * scale - input[i]) < 1e-4F);
+    }
+}
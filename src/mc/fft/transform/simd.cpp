@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "simd.hpp"
+
+#include <mc/core/array.hpp>
+#include <mc/core/atomic.hpp>
+#include <mc/core/cstdlib.hpp>
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+#endif
+
+namespace mc {
+
+namespace {
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+auto detectX86() -> SimdLevel
+{
+    auto info = Array<int, 4>{};
+    __cpuid(info.data(), 1);
+    auto const sse2    = (info[3] & (1 << 26)) != 0;
+    auto const fma     = (info[2] & (1 << 12)) != 0;
+    auto const osxsave = (info[2] & (1 << 27)) != 0;
+    auto const avx     = (info[2] & (1 << 28)) != 0;
+
+    // The OS has to save the ymm registers on context switches.
+    auto const xcr0  = osxsave ? _xgetbv(0) : 0U;
+    auto const osYmm = (xcr0 & 0x06U) == 0x06U;
+
+    __cpuidex(info.data(), 7, 0);
+    auto const avx2 = (info[1] & (1 << 5)) != 0;
+
+    // The AVX2 kernels are compiled with FMA as well
+    if (avx && osYmm && avx2 && fma) { return SimdLevel::avx2; }
+    if (sse2) { return SimdLevel::sse2; }
+    return SimdLevel::scalar;
+}
+#elif defined(__x86_64__) || defined(__i386__)
+auto detectX86() -> SimdLevel
+{
+    // Also checks that the OS saves the ymm registers. The AVX2 kernels are compiled with
+    // FMA as well, which is a separate feature bit.
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return SimdLevel::avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) { return SimdLevel::sse2; }
+    return SimdLevel::scalar;
+}
+#endif
+
+auto clampToHardware(SimdLevel level) -> SimdLevel
+{
+    auto const detected = detectSimdLevel();
+    if (level == SimdLevel::scalar) { return level; }
+    if (detected == SimdLevel::neon || level == SimdLevel::neon) {
+        return level == detected ? level : SimdLevel::scalar;
+    }
+    return level < detected ? level : detected;
+}
+
+auto fromEnvironment() -> SimdLevel
+{
+    auto const* name = std::getenv("MC_FFT_SIMD");
+    if (name == nullptr) { return detectSimdLevel(); }
+
+    for (auto level : {
+             SimdLevel::scalar,
+             SimdLevel::sse2,
+             SimdLevel::avx2,
+             SimdLevel::neon,
+         }) {
+        if (toString(level) == name) { return clampToHardware(level); }
+    }
+    return detectSimdLevel();
+}
+
+auto activeSimdLevel() -> std::atomic<SimdLevel>&
+{
+    static auto level = std::atomic<SimdLevel>{fromEnvironment()};
+    return level;
+}
+
+}  // namespace
+
+auto detectSimdLevel() -> SimdLevel
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    static auto const level = detectX86();
+    return level;
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    return SimdLevel::neon;
+#else
+    return SimdLevel::scalar;
+#endif
+}
+
+auto simdLevel() -> SimdLevel { return activeSimdLevel().load(); }
+
+auto forceSimdLevel(SimdLevel level) -> void { activeSimdLevel() = clampToHardware(level); }
+
+auto resetSimdLevel() -> void { activeSimdLevel() = fromEnvironment(); }
+
+}  // namespace mc
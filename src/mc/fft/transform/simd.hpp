@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/core/string.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define MC_FFT_HAS_TARGET_ATTRIBUTE 1
+    #define MC_FFT_ALWAYS_INLINE __attribute__((always_inline)) inline
+    #if defined(__clang__)
+        #define MC_FFT_TARGET(isa) __attribute__((target(isa)))
+    #else
+        // GCC only vectorizes loops without runtime checks at -O2
+        #define MC_FFT_TARGET(isa)                                                      \
+            __attribute__((target(isa)))                                                \
+            __attribute__((optimize("tree-vectorize", "vect-cost-model=dynamic")))
+    #endif
+#else
+    #define MC_FFT_HAS_TARGET_ATTRIBUTE 0
+    #define MC_FFT_ALWAYS_INLINE inline
+    #define MC_FFT_TARGET(isa)
+#endif
+
+// Kernels shared by a baseline and an MC_FFT_TARGET wrapper are MC_FFT_ALWAYS_INLINE,
+// otherwise the wrapper may compile to a jump into the baseline copy.
+
+namespace mc {
+
+/// Instruction set used by the kernels of the FFT layer. Ordered, a higher level implies
+/// all lower x86 levels. neon is the baseline on aarch64.
+///
+/// scalar runs the portable kernels & plans FFTW without SIMD codelets. sse2 & neon run
+/// the same portable kernels, with FFTW's SIMD codelets. avx2 (which includes FMA) runs
+/// the AVX2 kernels. The transform backend never changes, pffft's SIMD width is fixed
+/// at compile time.
+enum struct SimdLevel
+{
+    scalar,
+    sse2,
+    avx2,
+    neon,
+};
+
+[[nodiscard]] inline auto toString(SimdLevel level) -> String
+{
+    switch (level) {
+        case SimdLevel::scalar: return "scalar";
+        case SimdLevel::sse2: return "sse2";
+        case SimdLevel::avx2: return "avx2";
+        case SimdLevel::neon: return "neon";
+    }
+    return "scalar";
+}
+
+/// Best level supported by the CPU (and OS) the process is running on.
+[[nodiscard]] auto detectSimdLevel() -> SimdLevel;
+
+/// Level used when creating engines & selecting kernels. Defaults to detectSimdLevel(),
+/// can be lowered with forceSimdLevel or the MC_FFT_SIMD environment variable, which
+/// accepts the names returned by toString(SimdLevel).
+[[nodiscard]] auto simdLevel() -> SimdLevel;
+
+/// Forces a level for testing. Levels the CPU doesn't support are clamped to the
+/// detected level. Only affects engines created afterwards.
+auto forceSimdLevel(SimdLevel level) -> void;
+
+/// Drops a forced level, falls back to MC_FFT_SIMD or detectSimdLevel().
+auto resetSimdLevel() -> void;
+
+}  // namespace mc
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+#include <mc/fft/algorithm.hpp>
+
+#include <mc/core/cmath.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft: forceSimdLevel", "[dsp][fft]")
+{
+    auto const detected = detectSimdLevel();
+    REQUIRE(detectSimdLevel() == detected);
+
+    forceSimdLevel(SimdLevel::scalar);
+    REQUIRE(simdLevel() == SimdLevel::scalar);
+
+    // Levels the hardware doesn't support are clamped
+    forceSimdLevel(SimdLevel::avx2);
+    REQUIRE(simdLevel() != SimdLevel::neon);
+    REQUIRE((detected == SimdLevel::neon || simdLevel() <= detected));
+
+    resetSimdLevel();
+    REQUIRE(toString(SimdLevel::avx2) == "avx2");
+}
+
+TEST_CASE("fft: scalar SimdLevel", "[dsp][fft]")
+{
+    forceSimdLevel(SimdLevel::scalar);
+    for (auto const size : {size_t{48}, size_t{64}}) {
+        // The level selects kernels, not a different transform backend
+        visitRFFT(size, [](auto& engine) {
+            REQUIRE_FALSE(std::is_same_v<std::decay_t<decltype(engine)>, FFTW_Real_Float>);
+        });
+        visitFFT(size, [](auto& engine) {
+            using Engine = std::decay_t<decltype(engine)>;
+            REQUIRE_FALSE(std::is_same_v<Engine, FFTW_Complex_Float>);
+        });
+
+        auto engine = makeRFFT<float>(size);
+        auto input  = Vector<float>(size);
+        for (auto i = size_t{0}; i < size; ++i) { input[i] = std::sin(0.3F * float(i)); }
+
+        auto spectrum = Vector<Complex<float>>(size);
+        auto output   = Vector<float>(size);
+        rfft(engine, input, spectrum);
+        irfft(engine, spectrum, output);
+
+        for (auto i = size_t{0}; i < size; ++i) {
+            REQUIRE(std::abs(output[i] / float(size) - input[i]) < 1e-5F);
+        }
+    }
+
+    auto a      = Vector<Complex<float>>{{1.0F, 2.0F}, {3.0F, -1.0F}, {0.5F, 0.25F}};
+    auto b      = Vector<Complex<float>>{{-2.0F, 1.0F}, {4.0F, 4.0F}, {2.0F, -8.0F}};
+    auto scalar = Vector<Complex<float>>(a.size());
+    spectralCorrelation(a, b, scalar);
+
+    resetSimdLevel();
+    auto simd = Vector<Complex<float>>(a.size());
+    spectralCorrelation(a, b, simd);
+    for (auto i = size_t{0}; i < a.size(); ++i) {
+        REQUIRE(scalar[i] == a[i] * std::conj(b[i]));
+        REQUIRE(std::abs(simd[i] - scalar[i]) < 1e-6F);
+    }
+}
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/core/array.hpp>
+#include <mc/core/cstddef.hpp>
+#include <mc/core/new.hpp>
+#include <mc/core/type_traits.hpp>
+#include <mc/core/utility.hpp>
+
+namespace mc {
+
+/// Owning pointer to a polymorphic ConceptT, which stores objects of up to Capacity bytes
+/// inline instead of on the heap. Used by the type-erased FFT<T> & RFFT<T> wrappers.
+///
+/// ConceptT needs a virtual moveTo(void* storage) -> ConceptT*, which move constructs
+/// the object into the given storage.
+template<typename ConceptT, size_t Capacity>
+struct SmallBox
+{
+    template<typename ModelT>
+    static constexpr auto fitsInline = sizeof(ModelT) <= Capacity
+                                    && alignof(ModelT) <= alignof(std::max_align_t)
+                                    && std::is_nothrow_move_constructible_v<ModelT>;
+
+    template<typename ModelT, typename... Args>
+    [[nodiscard]] static auto make(Args&&... args) -> SmallBox
+    {
+        auto box = SmallBox{};
+        if constexpr (fitsInline<ModelT>) {
+            box._ptr    = new (box.storage()) ModelT(std::forward<Args>(args)...);
+            box._inline = true;
+        } else {
+            box._ptr = new ModelT(std::forward<Args>(args)...);
+        }
+        return box;
+    }
+
+    SmallBox() = default;
+    ~SmallBox() { reset(); }
+
+    SmallBox(SmallBox const& other)                    = delete;
+    auto operator=(SmallBox const& other) -> SmallBox& = delete;
+
+    SmallBox(SmallBox&& other) noexcept { moveFrom(other); }
+
+    auto operator=(SmallBox&& other) noexcept -> SmallBox&
+    {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] auto get() const noexcept -> ConceptT* { return _ptr; }
+    [[nodiscard]] auto operator->() const noexcept -> ConceptT* { return _ptr; }
+    [[nodiscard]] auto isInline() const noexcept -> bool { return _inline; }
+
+private:
+    auto storage() noexcept -> void* { return _storage.data(); }
+
+    auto moveFrom(SmallBox& other) noexcept -> void
+    {
+        if (other._ptr == nullptr) { return; }
+        if (other._inline) {
+            _ptr    = other._ptr->moveTo(storage());
+            _inline = true;
+            other.reset();
+        } else {
+            _ptr = std::exchange(other._ptr, nullptr);
+        }
+    }
+
+    auto reset() noexcept -> void
+    {
+        if (_ptr == nullptr) { return; }
+        if (_inline) {
+            _ptr->~ConceptT();
+        } else {
+            delete _ptr;
+        }
+        _ptr    = nullptr;
+        _inline = false;
+    }
+
+    alignas(std::max_align_t) Array<unsigned char, Capacity> _storage;
+    ConceptT* _ptr{nullptr};
+    bool _inline{false};
+};
+
+}  // namespace mc
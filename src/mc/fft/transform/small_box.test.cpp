@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/array.hpp>
+#include <mc/core/utility.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace mc;
+
+namespace {
+
+struct Shape
+{
+    virtual ~Shape()                              = default;
+    virtual auto moveTo(void* storage) -> Shape* = 0;
+    [[nodiscard]] virtual auto value() const -> int = 0;
+};
+
+template<size_t Size>
+struct Blob final : Shape
+{
+    explicit Blob(int v) : data{v} {}
+
+    auto moveTo(void* storage) -> Shape* override { return new (storage) Blob{*this}; }
+
+    [[nodiscard]] auto value() const -> int override { return data[0]; }
+
+    Array<int, Size> data{};
+};
+
+}  // namespace
+
+TEST_CASE("fft: SmallBox", "[dsp][fft]")
+{
+    using Box = SmallBox<Shape, 64>;
+    STATIC_REQUIRE(Box::fitsInline<Blob<4>>);
+    STATIC_REQUIRE_FALSE(Box::fitsInline<Blob<64>>);
+
+    auto small = Box::make<Blob<4>>(42);
+    REQUIRE(small.isInline());
+    REQUIRE(small->value() == 42);
+
+    auto large = Box::make<Blob<64>>(143);
+    REQUIRE_FALSE(large.isInline());
+    REQUIRE(large->value() == 143);
+
+    auto moved = std::move(small);
+    REQUIRE(moved.isInline());
+    REQUIRE(moved->value() == 42);
+    REQUIRE(small.get() == nullptr);  // NOLINT(bugprone-use-after-move)
+
+    moved = std::move(large);
+    REQUIRE_FALSE(moved.isInline());
+    REQUIRE(moved->value() == 143);
+}
+
+TEST_CASE("fft: FFT/RFFT store engines inline", "[dsp][fft]")
+{
+    STATIC_REQUIRE(FFT<float>::storesInline<PFFFT_Complex_Float>);
+    STATIC_REQUIRE(FFT<float>::storesInline<Bluestein_Complex_Float>);
+    STATIC_REQUIRE(FFT<double>::storesInline<FFTW_Complex_Double>);
+    STATIC_REQUIRE(RFFT<float>::storesInline<PFFFT_Real_Float>);
+    STATIC_REQUIRE(RFFT<float>::storesInline<PFFFT_Real_Via_Complex_Float>);
+    STATIC_REQUIRE(RFFT<float>::storesInline<Bluestein_Real_Float>);
+    STATIC_REQUIRE(RFFT<double>::storesInline<FFTW_Real_Double>);
+
+    auto const size = size_t{64};
+    auto const a    = generateRandomTestData(size);
+    auto expected   = Vector<Complex<float>>(size);
+    auto output     = Vector<Complex<float>>(size);
+
+    // The concrete engine & the moved wrapper produce the same spectrum
+    visitRFFT(size, [&](auto& engine) { rfft(engine, a, expected); });
+    auto engine = makeRFFT(size);
+    auto moved  = std::move(engine);
+    rfft(moved, a, output);
+    REQUIRE(output == expected);
+}
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "stft.hpp"
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/iterator.hpp>
+#include <mc/core/numbers.hpp>
+#include <mc/core/stdexcept.hpp>
+
+namespace mc {
+
+namespace {
+
+auto checkHopSize(Span<float const> window, size_t hopSize) -> size_t
+{
+    if (window.empty()) { raise<InvalidArgument>("stft: window must not be empty"); }
+    if (hopSize == 0 || hopSize > window.size()) {
+        raisef<InvalidArgument>(
+            "stft: hop size must be in [1, {}], got {}",
+            window.size(),
+            hopSize
+        );
+    }
+    return hopSize;
+}
+
+}  // namespace
+
+auto hannWindow(size_t size) -> Vector<float>
+{
+    auto window = Vector<float>(size);
+    for (auto i = size_t{0}; i < size; ++i) {
+        auto const phase = 2.0 * numbers::pi * static_cast<double>(i)
+                         / static_cast<double>(size);
+        window[i] = static_cast<float>(0.5 - 0.5 * std::cos(phase));
+    }
+    return window;
+}
+
+STFT::STFT(Span<float const> window, size_t hopSize)
+    : _hopSize{checkHopSize(window, hopSize)}
+    , _window(window.begin(), window.end())
+    , _engine{makeRFFT(window.size())}
+    , _ring(window.size())
+    , _frame(window.size())
+    , _packed(window.size())
+    , _spectrum(halfSpectrumSize(window.size()))
+{
+    reset();
+}
+
+auto STFT::frameSize() const noexcept -> size_t { return _window.size(); }
+
+auto STFT::hopSize() const noexcept -> size_t { return _hopSize; }
+
+auto STFT::bins() const noexcept -> size_t { return _spectrum.size(); }
+
+auto STFT::latency() const noexcept -> size_t { return frameSize() - hopSize(); }
+
+auto STFT::reset() -> void
+{
+    ranges::fill(_ring, 0.0F);
+    _writePos = 0;
+    _pending  = _hopSize;
+}
+
+auto STFT::write(Span<float const> block) -> size_t
+{
+    auto const size  = _ring.size();
+    auto const count = std::min(block.size(), _pending);
+    auto const first = std::min(count, size - _writePos);
+
+    auto const in = block.begin();
+    std::copy(in, std::next(in, static_cast<ptrdiff_t>(first)), &_ring[_writePos]);
+    std::copy(
+        std::next(in, static_cast<ptrdiff_t>(first)),
+        std::next(in, static_cast<ptrdiff_t>(count)),
+        _ring.begin()
+    );
+
+    _writePos = (_writePos + count) % size;
+    _pending -= count;
+    return count;
+}
+
+auto STFT::transformFrame() -> Span<Complex<float> const>
+{
+    // The oldest sample sits at the write position
+    auto const size = _ring.size();
+    auto const tail = size - _writePos;
+    for (auto i = size_t{0}; i < tail; ++i) {
+        _frame[i] = _ring[_writePos + i] * _window[i];
+    }
+    for (auto i = size_t{0}; i < _writePos; ++i) {
+        _frame[tail + i] = _ring[i] * _window[tail + i];
+    }
+    _pending = _hopSize;
+
+    if (size % 2 == 1) {
+        rfft(_engine, _frame, _packed);
+        auto const last = std::next(_packed.begin(), static_cast<ptrdiff_t>(bins()));
+        std::copy(_packed.begin(), last, _spectrum.begin());
+        return _spectrum;
+    }
+
+    auto const h      = size / 2;
+    auto const packed = Span<Complex<float>>{_packed}.first(h);
+    rfftPacked(_engine, _frame, packed);
+    std::copy(std::next(packed.begin()), packed.end(), std::next(_spectrum.begin()));
+    _spectrum[0] = {packed[0].real(), 0.0F};
+    _spectrum[h] = {packed[0].imag(), 0.0F};
+    return _spectrum;
+}
+
+ISTFT::ISTFT(Span<float const> window, size_t hopSize)
+    : _hopSize{checkHopSize(window, hopSize)}
+    , _window(window.begin(), window.end())
+    , _scale(hopSize)
+    , _engine{makeRFFT(window.size())}
+    , _ring(window.size())
+    , _packed(window.size())
+    , _frame(window.size())
+{
+    // Output sample j of a hop is covered by the window samples j, j + hop, ...
+    // The 1/N of the unnormalized inverse transform is folded in.
+    auto const size = window.size();
+    for (auto j = size_t{0}; j < hopSize; ++j) {
+        auto sum = 0.0;
+        for (auto i = j; i < size; i += hopSize) {
+            sum += static_cast<double>(window[i]) * static_cast<double>(window[i]);
+        }
+        if (sum < 1e-12) {
+            raise<InvalidArgument>("istft: window does not overlap-add for this hop size");
+        }
+        _scale[j] = static_cast<float>(1.0 / (sum * static_cast<double>(size)));
+    }
+}
+
+auto ISTFT::frameSize() const noexcept -> size_t { return _window.size(); }
+
+auto ISTFT::hopSize() const noexcept -> size_t { return _hopSize; }
+
+auto ISTFT::bins() const noexcept -> size_t { return halfSpectrumSize(frameSize()); }
+
+auto ISTFT::reset() -> void
+{
+    ranges::fill(_ring, 0.0F);
+    _readPos = 0;
+}
+
+auto ISTFT::push(Span<Complex<float> const> spectrum, Span<float> output) -> void
+{
+    MC_ASSERT(spectrum.size() >= bins());
+    MC_ASSERT(output.size() >= _hopSize);
+
+    auto const size = _ring.size();
+    if (size % 2 == 1) {
+        auto const last = std::next(spectrum.begin(), static_cast<ptrdiff_t>(bins()));
+        std::copy(spectrum.begin(), last, _packed.begin());
+        irfft(_engine, Span<Complex<float> const>{_packed}.first(bins()), _frame);
+    } else {
+        auto const h      = size / 2;
+        auto const packed = Span<Complex<float>>{_packed}.first(h);
+        auto const last   = std::next(spectrum.begin(), static_cast<ptrdiff_t>(h));
+        std::copy(std::next(spectrum.begin()), last, std::next(packed.begin()));
+        packed[0] = {spectrum[0].real(), spectrum[h].real()};
+        irfftPacked(_engine, packed, _frame);
+    }
+
+    auto const tail = size - _readPos;
+    for (auto i = size_t{0}; i < tail; ++i) {
+        _ring[_readPos + i] += _frame[i] * _window[i];
+    }
+    for (auto i = size_t{0}; i < _readPos; ++i) {
+        _ring[i] += _frame[tail + i] * _window[tail + i];
+    }
+
+    // No later frame reaches the first hop samples, they are complete.
+    auto pos = _readPos;
+    for (auto j = size_t{0}; j < _hopSize; ++j) {
+        output[j]  = _ring[pos] * _scale[j];
+        _ring[pos] = 0.0F;
+        pos        = pos + 1 == size ? 0 : pos + 1;
+    }
+    _readPos = pos;
+}
+
+}  // namespace mc
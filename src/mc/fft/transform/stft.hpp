@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/fft/transform/aligned_allocator.hpp>
+#include <mc/fft/transform/rfft.hpp>
+
+#include <mc/core/complex.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+/// Periodic Hann window, overlap-adds to a constant for hop sizes of size / 2^k.
+[[nodiscard]] auto hannWindow(size_t size) -> Vector<float>;
+
+/// Streaming short-time Fourier transform. Samples are pushed in blocks of any size,
+/// every hopSize samples the last window.size() samples are windowed & transformed.
+/// Frames hold the halfSpectrumSize(frameSize) non-redundant bins.
+///
+/// The stream starts with frameSize - hopSize zeros, so the first frame is emitted after
+/// hopSize samples & an ISTFT reproduces the input delayed by exactly latency() samples.
+/// All buffers are allocated by the constructor, push doesn't allocate.
+struct STFT
+{
+    STFT(Span<float const> window, size_t hopSize);
+
+    [[nodiscard]] auto frameSize() const noexcept -> size_t;
+    [[nodiscard]] auto hopSize() const noexcept -> size_t;
+    [[nodiscard]] auto bins() const noexcept -> size_t;
+    [[nodiscard]] auto latency() const noexcept -> size_t;
+
+    /// Calls onFrame(Span<Complex<float> const>) for every frame completed by the block.
+    /// The span is only valid during the call.
+    template<typename Callback>
+    auto push(Span<float const> block, Callback&& onFrame) -> void
+    {
+        while (!block.empty()) {
+            block = block.subspan(write(block));
+            if (_pending == 0) { onFrame(transformFrame()); }
+        }
+    }
+
+    /// Drops all buffered samples, the next frame starts a new stream.
+    auto reset() -> void;
+
+private:
+    auto write(Span<float const> block) -> size_t;
+    auto transformFrame() -> Span<Complex<float> const>;
+
+    size_t _hopSize;
+    Vector<float> _window;
+    RFFT<float> _engine;
+
+    Vector<float> _ring;
+    size_t _writePos{0};
+    size_t _pending{0};
+
+    AlignedVector<float> _frame;
+    AlignedVector<Complex<float>> _packed;
+    Vector<Complex<float>> _spectrum;
+};
+
+/// Inverse of STFT by weighted overlap-add. Every frame is transformed back, windowed
+/// again & added to the output, which is normalized by the overlapping squared window
+/// sum. Raises InvalidArgument if that sum is zero anywhere, e.g. if hopSize is larger
+/// than the non-zero part of the window. Doesn't allocate after construction.
+struct ISTFT
+{
+    ISTFT(Span<float const> window, size_t hopSize);
+
+    [[nodiscard]] auto frameSize() const noexcept -> size_t;
+    [[nodiscard]] auto hopSize() const noexcept -> size_t;
+    [[nodiscard]] auto bins() const noexcept -> size_t;
+
+    /// Adds one frame of bins() bins & writes the hopSize() samples it completes.
+    auto push(Span<Complex<float> const> spectrum, Span<float> output) -> void;
+
+    /// Drops all buffered samples.
+    auto reset() -> void;
+
+private:
+    size_t _hopSize;
+    Vector<float> _window;
+    Vector<float> _scale;
+    RFFT<float> _engine;
+
+    Vector<float> _ring;
+    size_t _readPos{0};
+
+    AlignedVector<Complex<float>> _packed;
+    AlignedVector<float> _frame;
+};
+
+}  // namespace mc
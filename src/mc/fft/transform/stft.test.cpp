@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cmath.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/tuple.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+namespace {
+
+// Pushes the signal in blocks of varying size, the frames are collected in a flat vector.
+auto analyze(STFT& stft, Span<float const> signal) -> Vector<Complex<float>>
+{
+    auto frames    = Vector<Complex<float>>{};
+    auto blockSize = size_t{1};
+    while (!signal.empty()) {
+        auto const n = std::min(blockSize, signal.size());
+        stft.push(signal.first(n), [&frames](Span<Complex<float> const> frame) {
+            frames.insert(frames.end(), frame.begin(), frame.end());
+        });
+        signal    = signal.subspan(n);
+        blockSize = blockSize * 3 % 97 + 1;
+    }
+    return frames;
+}
+
+}  // namespace
+
+TEST_CASE("fft: STFT", "[dsp][fft]")
+{
+    auto const [frameSize, hopSize] = GENERATE(
+        std::tuple{size_t{512}, size_t{128}},
+        std::tuple{size_t{45}, size_t{15}},
+        std::tuple{size_t{100}, size_t{30}}
+    );
+
+    auto const window = hannWindow(frameSize);
+    auto const signal = generateRandomTestData(frameSize * 8);
+    auto stft         = STFT{window, hopSize};
+    REQUIRE(stft.bins() == halfSpectrumSize(frameSize));
+    REQUIRE(stft.latency() == frameSize - hopSize);
+
+    auto const frames = analyze(stft, signal);
+    auto const count  = signal.size() / hopSize;
+    REQUIRE(frames.size() == count * stft.bins());
+
+    // Frame k covers the zero prefixed stream from k * hop on
+    auto padded = Vector<float>(stft.latency(), 0.0F);
+    padded.insert(padded.end(), signal.begin(), signal.end());
+
+    auto engine   = FFTW_Real_Float{frameSize};
+    auto frame    = Vector<float>(frameSize);
+    auto expected = Vector<Complex<float>>(frameSize);
+    for (auto k = size_t{0}; k < count; ++k) {
+        for (auto i = size_t{0}; i < frameSize; ++i) {
+            frame[i] = padded[k * hopSize + i] * window[i];
+        }
+        rfft(engine, frame, expected);
+        for (auto b = size_t{0}; b < stft.bins(); ++b) {
+            REQUIRE(std::abs(frames[k * stft.bins() + b] - expected[b]) < 1e-3F);
+        }
+    }
+}
+
+TEST_CASE("fft: ISTFT", "[dsp][fft]")
+{
+    auto const [frameSize, hopSize, rectangular] = GENERATE(
+        std::tuple{size_t{512}, size_t{128}, false},
+        std::tuple{size_t{45}, size_t{15}, false},
+        std::tuple{size_t{100}, size_t{30}, false},
+        std::tuple{size_t{64}, size_t{64}, true}
+    );
+
+    auto const window = rectangular ? Vector<float>(frameSize, 1.0F) : hannWindow(frameSize);
+    auto const signal = generateRandomTestData(frameSize * 8);
+
+    auto stft   = STFT{window, hopSize};
+    auto istft  = ISTFT{window, hopSize};
+    auto output = Vector<float>{};
+    auto hop    = Vector<float>(hopSize);
+    stft.push(signal, [&](Span<Complex<float> const> frame) {
+        istft.push(frame, hop);
+        output.insert(output.end(), hop.begin(), hop.end());
+    });
+
+    auto const latency = stft.latency();
+    REQUIRE(output.size() == signal.size() / hopSize * hopSize);
+    for (auto i = size_t{0}; i < output.size(); ++i) {
+        auto const expected = i < latency ? 0.0F : signal[i - latency];
+        REQUIRE(std::abs(output[i] - expected) < 1e-4F);
+    }
+}
+
+TEST_CASE("fft: STFT invalid arguments", "[dsp][fft]")
+{
+    auto const window = hannWindow(64);
+    REQUIRE_THROWS_AS(STFT(window, 0), InvalidArgument);
+    REQUIRE_THROWS_AS(STFT(window, 65), InvalidArgument);
+    REQUIRE_THROWS_AS(ISTFT(Vector<float>{}, 1), InvalidArgument);
+
+    // Only every second sample of the window is covered
+    auto const sparse = Vector<float>{1.0F, 0.0F, 1.0F, 0.0F};
+    REQUIRE_THROWS_AS(ISTFT(sparse, 2), InvalidArgument);
+}
@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include "thread_pool.hpp"
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/cassert.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/stdexcept.hpp>
+
+namespace mc {
+
+ThreadPool::ThreadPool(size_t threads)
+{
+    if (threads == 0) {
+        raise<InvalidArgument>("thread pool: threads must be greater than zero");
+    }
+
+    _threads.reserve(threads - 1);
+    for (auto i = size_t{1}; i < threads; ++i) {
+        _threads.emplace_back([this, i] { loop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        auto const lock = std::scoped_lock{_mutex};
+        _stop           = true;
+    }
+    _start.notify_all();
+    for (auto& thread : _threads) { thread.join(); }
+}
+
+auto ThreadPool::threads() const noexcept -> size_t { return _threads.size() + 1; }
+
+// Chunks are split like parallelFor, a pool thread without a chunk only reports back
+auto ThreadPool::dispatch(size_t count, void* context, Task task) -> void
+{
+    auto const n = std::min(threads(), count);
+    if (n <= 1) {
+        task(context, 0, 0, count);
+        return;
+    }
+
+    auto const chunk = (count + n - 1) / n;
+    {
+        auto const lock = std::scoped_lock{_mutex};
+        MC_ASSERT(_pending == 0);
+        _task    = task;
+        _context = context;
+        _count   = count;
+        _chunk   = chunk;
+        _pending = _threads.size();
+        ++_generation;
+    }
+    _start.notify_all();
+
+    // The pool threads still use context, even if the first chunk throws
+    auto const wait = [this] {
+        auto lock = std::unique_lock{_mutex};
+        _done.wait(lock, [this] { return _pending == 0; });
+    };
+
+    try {
+        task(context, 0, 0, chunk);
+    } catch (...) {
+        wait();
+        throw;
+    }
+    wait();
+}
+
+auto ThreadPool::loop(size_t worker) -> void
+{
+    auto seen = size_t{0};
+    while (true) {
+        auto lock = std::unique_lock{_mutex};
+        _start.wait(lock, [this, seen] { return _stop || _generation != seen; });
+        if (_stop) { return; }
+
+        seen             = _generation;
+        auto const task  = _task;
+        auto* context    = _context;
+        auto const first = std::min(_count, worker * _chunk);
+        auto const last  = std::min(_count, first + _chunk);
+        lock.unlock();
+
+        if (first < last) { task(context, worker, first, last); }
+
+        lock.lock();
+        if (--_pending == 0) { _done.notify_one(); }
+    }
+}
+
+}  // namespace mc
@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#pragma once
+
+#include <mc/core/config.hpp>
+
+#include <mc/core/condition_variable.hpp>
+#include <mc/core/cstddef.hpp>
+#include <mc/core/mutex.hpp>
+#include <mc/core/thread.hpp>
+#include <mc/core/vector.hpp>
+
+namespace mc {
+
+/// Threads that stay alive across calls of run, for objects that split the same loop
+/// over their workers again & again. The calling thread counts as one of the threads,
+/// the pool starts threads - 1. Nothing is allocated per run.
+struct ThreadPool
+{
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const& other)                    = delete;
+    auto operator=(ThreadPool const& other) -> ThreadPool& = delete;
+
+    [[nodiscard]] auto threads() const noexcept -> size_t;
+
+    /// Same as parallelFor(workers, count, func), but the chunks after the first run on
+    /// the pool threads. workers needs at least threads() elements. Returns once all
+    /// chunks are done. Not reentrant, calls must not overlap.
+    template<typename Workers, typename Func>
+    auto run(Workers& workers, size_t count, Func func) -> void
+    {
+        auto job = [&workers, &func](size_t worker, size_t first, size_t last) {
+            func(workers[worker], first, last);
+        };
+
+        using Job = decltype(job);
+        dispatch(count, &job, [](void* context, size_t worker, size_t first, size_t last) {
+            (*static_cast<Job*>(context))(worker, first, last);
+        });
+    }
+
+private:
+    using Task = void (*)(void* context, size_t worker, size_t first, size_t last);
+
+    auto dispatch(size_t count, void* context, Task task) -> void;
+    auto loop(size_t worker) -> void;
+
+    Vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    size_t _generation{0};
+    size_t _pending{0};
+    bool _stop{false};
+
+    // the current run, written under the lock before _generation is bumped
+    Task _task{nullptr};
+    void* _context{nullptr};
+    size_t _count{0};
+    size_t _chunk{0};
+};
+
+}  // namespace mc
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: BSL-1.0
+
+#include <mc/fft/transform/thread_pool.hpp>
+
+#include <mc/core/algorithm.hpp>
+#include <mc/core/exception.hpp>
+#include <mc/core/numeric.hpp>
+#include <mc/core/stdexcept.hpp>
+#include <mc/core/vector.hpp>
+#include <mc/testing/test.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+using namespace mc;
+
+TEST_CASE("fft: ThreadPool", "[dsp][fft]")
+{
+    auto const threads = GENERATE(size_t{1}, size_t{2}, size_t{3}, size_t{8});
+
+    auto pool = ThreadPool{threads};
+    REQUIRE(pool.threads() == threads);
+
+    // One counter per worker, every index has to be visited once per run by one worker
+    auto workers = Vector<size_t>(threads);
+    auto visits  = Vector<size_t>(100);
+    for (auto count : {size_t{0}, size_t{1}, size_t{5}, size_t{7}, size_t{100}}) {
+        ranges::fill(workers, size_t{0});
+        ranges::fill(visits, size_t{0});
+
+        pool.run(workers, count, [&visits](size_t& worker, size_t first, size_t last) {
+            for (auto i = first; i < last; ++i) { ++visits[i]; }
+            worker += last - first;
+        });
+
+        auto once = true;
+        for (auto i = size_t{0}; i < visits.size(); ++i) {
+            once = once && visits[i] == (i < count ? 1U : 0U);
+        }
+        REQUIRE(once);
+        REQUIRE(std::accumulate(workers.begin(), workers.end(), size_t{0}) == count);
+    }
+
+    REQUIRE_THROWS_AS(ThreadPool{0}, InvalidArgument);
+}
@@ -2,14 +2,126 @@
 
 #include "common.hpp"
 
+#include <mc/core/config.hpp>
+
 #include <mc/fft/transform/fft.hpp>
+#include <mc/fft/transform/simd.hpp>
 
+#include <mc/core/array.hpp>
+#include <mc/core/cassert.hpp>
 #include <mc/core/cmath.hpp>
 #include <mc/core/cstdlib.hpp>
 #include <mc/core/cstring.hpp>
+#include <mc/core/vector.hpp>
 
 namespace mc {
 
+namespace {
+
+// Outputs per block, for each of the two filters
+constexpr auto polyphaseLanes = size_t{16};
+
+// y[i] = sum_r f[2r] * x[2(i + r)] + f[2r + 1] * x[2(i + r) + 1]
+MC_FFT_ALWAYS_INLINE auto polyphase(
+    float const* x,
+    PolyphaseFilters const& f,
+    float* cA,
+    float* cD,
+    size_t count
+) -> void
+{
+    auto const pairs = f.lowPass.size() / 2;
+    auto const* lp   = f.lowPass.data();
+    auto const* hp   = f.highPass.data();
+
+    auto i = size_t{0};
+    for (; i + polyphaseLanes <= count; i += polyphaseLanes) {
+        auto a = Array<float, polyphaseLanes>{};
+        auto d = Array<float, polyphaseLanes>{};
+        for (auto r = size_t{0}; r < pairs; ++r) {
+            auto const* s = x + 2 * (i + r);
+            for (auto j = size_t{0}; j < polyphaseLanes; ++j) {
+                a[j] += lp[2 * r] * s[2 * j] + lp[2 * r + 1] * s[2 * j + 1];
+                d[j] += hp[2 * r] * s[2 * j] + hp[2 * r + 1] * s[2 * j + 1];
+            }
+        }
+        std::copy(a.begin(), a.end(), cA + i);
+        std::copy(d.begin(), d.end(), cD + i);
+    }
+
+    for (; i < count; ++i) {
+        auto a = 0.0F;
+        auto d = 0.0F;
+        for (auto r = size_t{0}; r < 2 * pairs; ++r) {
+            a += lp[r] * x[2 * i + r];
+            d += hp[r] * x[2 * i + r];
+        }
+        cA[i] = a;
+        cD[i] = d;
+    }
+}
+
+#if MC_FFT_HAS_TARGET_ATTRIBUTE
+MC_FFT_TARGET("avx2,fma")
+auto polyphaseAVX2(
+    float const* x,
+    PolyphaseFilters const& f,
+    float* cA,
+    float* cD,
+    size_t count
+) -> void
+{
+    polyphase(x, f, cA, cD, count);
+}
+#endif
+
+}  // namespace
+
+// Pair r holds the taps l = 2q + 1 & 2q with q = pairs - 1 - r. For output i the pair
+// reads x[first + 2i - 2q - 1] & x[first + 2i - 2q], i.e. window[2(i + r)] & the next
+// sample, with the window starting at first + 1 - 2 * pairs.
+PolyphaseFilters::PolyphaseFilters(Span<float const> lpd, Span<float const> hpd)
+{
+    MC_ASSERT(lpd.size() == hpd.size());
+
+    auto const pairs = (lpd.size() + 1) / 2;
+    auto const tap   = [](Span<float const> h, size_t l) {
+        return l < h.size() ? h[l] : 0.0F;
+    };
+
+    lowPass.resize(2 * pairs);
+    highPass.resize(2 * pairs);
+    for (auto r = size_t{0}; r < pairs; ++r) {
+        auto const q        = pairs - 1 - r;
+        lowPass[2 * r]      = tap(lpd, 2 * q + 1);
+        lowPass[2 * r + 1]  = tap(lpd, 2 * q);
+        highPass[2 * r]     = tap(hpd, 2 * q + 1);
+        highPass[2 * r + 1] = tap(hpd, 2 * q);
+    }
+}
+
+auto dwtPolyphase(
+    float const* x,
+    size_t first,
+    PolyphaseFilters const& filters,
+    float* cA,
+    float* cD,
+    size_t count
+) -> void
+{
+    if (count == 0 || filters.lowPass.empty()) { return; }
+
+    auto const* window = x + first + 1 - filters.lowPass.size();
+
+#if MC_FFT_HAS_TARGET_ATTRIBUTE
+    if (simdLevel() == SimdLevel::avx2) {
+        return polyphaseAVX2(window, filters, cA, cD, count);
+    }
+#endif
+
+    polyphase(window, filters, cA, cD, count);
+}
+
 auto dwtPerStride(
     float const* inp,
     int n,
@@ -4,6 +4,8 @@
 
 #include <mc/core/cstddef.hpp>
 #include <mc/core/memory.hpp>
+#include <mc/core/span.hpp>
+#include <mc/core/vector.hpp>
 
 namespace mc {
 
@@ -33,6 +35,32 @@ auto dwtSymStride(
     int ostride
 ) -> void;
 
+/// Analysis filters for dwtPolyphase, split into pairs of an odd & an even tap. The
+/// pairs are reversed and an odd length is padded with a zero tap, so each output reads
+/// the even & odd samples of one contiguous window. Built once per transform.
+struct PolyphaseFilters
+{
+    PolyphaseFilters() = default;
+    PolyphaseFilters(Span<float const> lpd, Span<float const> hpd);
+
+    Vector<float> lowPass;
+    Vector<float> highPass;
+};
+
+/// Analysis step of the DWT on an already extended signal x, computes only the outputs
+/// kept by the downsampling: cA[i] = sum_l lpd[l] * x[first + 2i - l], cD likewise with
+/// hpd, for i < count. Both filters run in one pass and read x in place, which has to
+/// hold the samples [first + 1 - taps, first + 2 * count - 2], with taps rounded up to
+/// an even number.
+auto dwtPolyphase(
+    float const* x,
+    size_t first,
+    PolyphaseFilters const& filters,
+    float* cA,
+    float* cD,
+    size_t count
+) -> void;
+
 auto modwtPerStride(
     int m,
     float const* inp,
@@ -32,7 +32,7 @@ WaveletTransform::WaveletTransform(
     , _levels{j}
     , _signalLength{siglength}
     , _method{method}
-    , convolver{nullptr}
+    , polyphase{w.lpd(), w.hpd()}
     , modwtsiglength{siglength}
     , lenlength{_levels + 2}
     , MaxIter{maxIterations(siglength, w.size())}
@@ -162,112 +162,123 @@ auto WaveletTransform::detail(size_t level) const -> Span<float>
     return {&_output[iter], static_cast<size_t>(length[level])};
 }
 
-static auto wconv(WaveletTransform& wt, Span<float> sig, Span<float const> filt, float* oup)
-    -> void
+// Resolves ConvolutionMethod::automatic for a convolution of the given sizes. The FFT
+// path of the transform stands in for overlap-save, its filter spectra are cached.
+static auto convMethod(WaveletTransform const& wt, size_t signalSize, size_t filterSize)
+    -> ConvolutionMethod
 {
-    if (wt.convMethod() == ConvolutionMethod::direct) {
-        convolute<float>(sig, filt, oup);
-        return;
+    auto method = wt.convMethod();
+    if (method == ConvolutionMethod::automatic) {
+        method = selectConvolutionMethod(signalSize, filterSize);
     }
+    return method == ConvolutionMethod::direct ? method : ConvolutionMethod::fft;
+}
 
-    MC_ASSERT(wt.convMethod() == ConvolutionMethod::fft);
-    if (wt.cfftset == 0) {
-        wt.convolver = makeUnique<FFTConvolver>(mc::size(sig), mc::size(filt));
-        convolute(*wt.convolver, sig, filt, oup);
-    } else {
-        convolute(*wt.convolver, sig, filt, oup);
+static auto fftConvolver(WaveletTransform& wt, size_t signalSize, size_t patchSize)
+    -> WaveletConvolver&
+{
+    for (auto& c : wt.convolvers) {
+        auto const& convolver = *c.convolver;
+        if (convolver.signalSize() == signalSize && convolver.patchSize() == patchSize) {
+            return c;
+        }
     }
+
+    auto convolver = makeUnique<FFTConvolver>(signalSize, patchSize);
+    return wt.convolvers.emplace_back(WaveletConvolver{std::move(convolver), {}});
 }
 
-static auto dwtPer(WaveletTransform& wt, float* inp, int n, float* cA, int lenCA, float* cD)
-    -> void
+// Full convolution with a method resolved by convMethod, the callers pick it once for the
+// whole transform.
+static auto wconv(
+    WaveletTransform& wt,
+    ConvolutionMethod method,
+    Span<float> sig,
+    Span<float const> filt,
+    float* oup
+) -> void
 {
+    MC_ASSERT(method != ConvolutionMethod::automatic);
 
-    dwtPerStride(
-        inp,
-        n,
-        wt.wave().lpd().data(),
-        wt.wave().hpd().data(),
-        wt.wave().lpd().size(),
-        cA,
-        lenCA,
-        cD,
-        1,
-        1
-    );
+    if (method == ConvolutionMethod::direct) {
+        convolute<float>(sig, filt, oup);
+        return;
+    }
+
+    // Each distinct filter is bound once, later calls only transform the signal.
+    auto& c          = fftConvolver(wt, mc::size(sig), mc::size(filt));
+    auto const bound = ranges::find_if(c.filters, [filt](auto const& f) {
+        return ranges::equal(f, filt);
+    });
+
+    auto patch = static_cast<size_t>(std::distance(c.filters.begin(), bound));
+    if (bound == c.filters.end()) {
+        c.filters.emplace_back(filt.begin(), filt.end());
+        patch = c.convolver->bindPatch(filt);
+    }
+    c.convolver->convolute(sig, patch, oup);
 }
 
-static auto dwtSym(WaveletTransform& wt, float* inp, int n, float* cA, int lenCA, float* cD)
-    -> void
+// One analysis level on the extended signal. cA[i] & cD[i] are the full convolutions at
+// first + 2i. The direct method only computes these with the polyphase kernel, the FFT
+// computes all outputs and drops every other one.
+static auto analysis(
+    WaveletTransform& wt,
+    ConvolutionMethod method,
+    Span<float> signal,
+    size_t first,
+    size_t count,
+    float* cA,
+    float* cD
+) -> void
 {
+    auto const& lpd = wt.wave().lpd();
+    auto const& hpd = wt.wave().hpd();
 
-    dwtSymStride(
-        inp,
-        n,
-        wt.wave().lpd().data(),
-        wt.wave().hpd().data(),
-        wt.wave().lpd().size(),
-        cA,
-        lenCA,
-        cD,
-        1,
-        1
-    );
+    if (method == ConvolutionMethod::direct) {
+        dwtPolyphase(signal.data(), first, wt.polyphase, cA, cD, count);
+        return;
+    }
+
+    auto cAUndec    = makeUnique<float[]>(signal.size() + lpd.size() - 1);
+    auto const last = 2 * (count - 1) + 1;
+
+    wconv(wt, method, signal, lpd, cAUndec.get());
+    downSample<float>(cAUndec.get() + first, last, 2U, cA);
+
+    wconv(wt, method, signal, hpd, cAUndec.get());
+    downSample<float>(cAUndec.get() + first, last, 2U, cD);
 }
 
-static auto dwt1(WaveletTransform& wt, float* sig, size_t lenSig, float* cA, float* cD)
-    -> void
+static auto dwt1(
+    WaveletTransform& wt,
+    ConvolutionMethod method,
+    float* sig,
+    size_t lenSig,
+    float* cA,
+    float* cD
+) -> void
 {
-    if (wt.extension() == SignalExtension::periodic) {
-        auto lenAvg  = (wt.wave().lpd().size() + wt.wave().hpd().size()) / 2;
-        auto signal  = makeUnique<float[]>(lenSig + lenAvg + (lenSig % 2));
-        lenSig       = periodicExtension({sig, lenSig}, lenAvg / 2, signal.get());
-        auto cAUndec = makeUnique<float[]>(lenSig + lenAvg + wt.wave().lpd().size() - 1);
-
-        if (wt.wave().lpd().size() == wt.wave().hpd().size()
-            && (wt.convMethod() == ConvolutionMethod::fft)) {
-            wt.convolver
-                = makeUnique<FFTConvolver>(lenSig + lenAvg, wt.wave().lpd().size());
-            wt.cfftset = 1;
-        } else if (!(wt.wave().lpd().size() == wt.wave().hpd().size())) {
-            raise<InvalidArgument>("decomposition filters must have the same length.");
-        }
+    if (wt.wave().lpd().size() != wt.wave().hpd().size()) {
+        raise<InvalidArgument>("decomposition filters must have the same length.");
+    }
 
-        wconv(wt, {signal.get(), (lenSig + lenAvg)}, wt.wave().lpd(), cAUndec.get());
-        downSample<float>(cAUndec.get() + lenAvg, static_cast<size_t>(lenSig), 2U, cA);
+    auto const lf = wt.wave().lpd().size();  // lpd and hpd have the same length
 
-        wconv(wt, {signal.get(), (lenSig + lenAvg)}, wt.wave().hpd(), cAUndec.get());
-        downSample<float>(cAUndec.get() + lenAvg, static_cast<size_t>(lenSig), 2U, cD);
+    if (wt.extension() == SignalExtension::periodic) {
+        auto signal = makeUnique<float[]>(lenSig + lf + (lenSig % 2));
+        lenSig      = periodicExtension({sig, lenSig}, lf / 2, signal.get());
+        analysis(wt, method, {signal.get(), lenSig + lf}, lf, lenSig / 2, cA, cD);
 
     } else if (wt.extension() == SignalExtension::symmetric) {
-        auto lf      = wt.wave().lpd().size();  // lpd and hpd have the same length
-        auto signal  = makeUnique<float[]>(lenSig + 2 * (lf - 1));
-        lenSig       = symmetricExtension({sig, (size_t)lenSig}, lf - 1, signal.get());
-        auto cAUndec = makeUnique<float[]>(lenSig + 3 * (lf - 1));
-
-        if (wt.wave().lpd().size() == wt.wave().hpd().size()
-            && (wt.convMethod() == ConvolutionMethod::fft)) {
-            wt.convolver = makeUnique<FFTConvolver>(lenSig + 2 * (lf - 1), lf);
-            wt.cfftset   = 1;
-        } else if (!(wt.wave().lpd().size() == wt.wave().hpd().size())) {
-            raise<InvalidArgument>("decomposition filters must have the same length.");
-        }
-
-        wconv(wt, {signal.get(), lenSig + 2U * (lf - 1U)}, wt.wave().lpd(), cAUndec.get());
-        downSample<float>(cAUndec.get() + lf, lenSig + lf - 2U, 2, cA);
-
-        wconv(wt, {signal.get(), lenSig + 2 * (lf - 1)}, wt.wave().hpd(), cAUndec.get());
-        downSample<float>(cAUndec.get() + lf, lenSig + lf - 2U, 2, cD);
+        auto signal = makeUnique<float[]>(lenSig + 2 * (lf - 1));
+        lenSig      = symmetricExtension({sig, lenSig}, lf - 1, signal.get());
+        auto count  = (lenSig + lf - 3) / 2 + 1;
+        analysis(wt, method, {signal.get(), lenSig + 2 * (lf - 1)}, lf, count, cA, cD);
 
     } else {
         raise<InvalidArgument>("Signal extension can be either per or sym");
     }
-
-    if (wt.wave().lpd().size() == wt.wave().hpd().size()
-        && (wt.convMethod() == ConvolutionMethod::fft)) {
-
-        wt.cfftset = 0;
-    }
 }
 
 auto dwt(WaveletTransform& wt, float const* inp) -> void
@@ -290,6 +301,8 @@ auto dwt(WaveletTransform& wt, float const* inp) -> void
     auto n  = tempLen;
     auto lp = wt.wave().lpd().size();
 
+    auto const method = convMethod(wt, tempLen, lp);
+
     if (wt.extension() == SignalExtension::periodic) {
         auto idx = j;
         while (idx > 0) {
@@ -305,11 +318,7 @@ auto dwt(WaveletTransform& wt, float const* inp) -> void
         for (auto iter = 0; iter < j; ++iter) {
             auto const lenCA = wt.length[j - iter];
             n -= lenCA;
-            if (wt.convMethod() == ConvolutionMethod::fft) {
-                dwt1(wt, orig.get(), tempLen, orig2.get(), wt.params.get() + n);
-            } else {
-                dwtPer(wt, orig.get(), tempLen, orig2.get(), lenCA, wt.params.get() + n);
-            }
+            dwt1(wt, method, orig.get(), tempLen, orig2.get(), wt.params.get() + n);
             tempLen = wt.length[j - iter];
             if (iter == j - 1) {
                 for (size_t i = 0; i < lenCA; ++i) { wt.params[i] = orig2[i]; }
@@ -333,11 +342,7 @@ auto dwt(WaveletTransform& wt, float const* inp) -> void
         for (auto iter = 0; iter < j; ++iter) {
             auto const lenCA = wt.length[j - iter];
             n -= lenCA;
-            if (wt.convMethod() == ConvolutionMethod::fft) {
-                dwt1(wt, orig.get(), tempLen, orig2.get(), wt.params.get() + n);
-            } else {
-                dwtSym(wt, orig.get(), tempLen, orig2.get(), lenCA, wt.params.get() + n);
-            }
+            dwt1(wt, method, orig.get(), tempLen, orig2.get(), wt.params.get() + n);
             tempLen = wt.length[j - iter];
 
             if (iter == j - 1) {
@@ -353,6 +358,7 @@ auto dwt(WaveletTransform& wt, float const* inp) -> void
 
 static auto idwt1(
     WaveletTransform& wt,
+    ConvolutionMethod method,
     float* temp,
     float* cAUp,
     float* cA,
@@ -374,15 +380,11 @@ static auto idwt1(
 
     auto n2 = 2 * lenCA + lenAvg;
 
-    if (wt.wave().lpr().size() == wt.wave().hpr().size()
-        && (wt.convMethod() == ConvolutionMethod::fft)) {
-        wt.convolver = makeUnique<FFTConvolver>(n2, lenAvg);
-        wt.cfftset   = 1;
-    } else if (!(wt.wave().lpr().size() == wt.wave().hpr().size())) {
+    if (wt.wave().lpr().size() != wt.wave().hpr().size()) {
         raise<InvalidArgument>("Decomposition Filters must have the same length");
     }
 
-    wconv(wt, {temp, n2}, {wt.wave().lpr().data(), lenAvg}, xLp);
+    wconv(wt, method, {temp, n2}, {wt.wave().lpr().data(), lenAvg}, xLp);
 
     upSampleEven(cD, cD + lenCD, cAUp, u);
 
@@ -390,17 +392,11 @@ static auto idwt1(
 
     n2 = 2 * lenCD + lenAvg;
 
-    wconv(wt, {temp, n2}, {wt.wave().hpr().data(), lenAvg}, xHp);
+    wconv(wt, method, {temp, n2}, {wt.wave().hpr().data(), lenAvg}, xHp);
 
     for (auto i = lenAvg - 1; i < n + lenAvg - 1; ++i) {
         x[i - lenAvg + 1] = xLp[i] + xHp[i];
     }
-
-    if (wt.wave().lpr().size() == wt.wave().hpr().size()
-        && (wt.convMethod() == ConvolutionMethod::fft)) {
-
-        wt.cfftset = 0;
-    }
 }
 
 static auto idwtPer(WaveletTransform& wt, float* cA, int lenCA, float* cD, float* x) -> void
@@ -447,8 +443,9 @@ auto idwt(WaveletTransform& wt, float* dwtop) -> void
     auto appLen = wt.length[0];
     auto out    = makeUnique<float[]>(wt.signalLength() + 1);
 
+    auto const method = convMethod(wt, wt.signalLength(), wt.wave().lpr().size());
     if ((wt.extension() == SignalExtension::periodic)
-        && (wt.convMethod() == ConvolutionMethod::fft)) {
+        && (method == ConvolutionMethod::fft)) {
         appLen = wt.length[0];
         detLen = wt.length[1];
         n      = 2 * wt.length[j];
@@ -465,6 +462,7 @@ auto idwt(WaveletTransform& wt, float* dwtop) -> void
         for (auto i = 0; i < j; ++i) {
             idwt1(
                 wt,
+                method,
                 temp.get(),
                 cAUp.get(),
                 out.get(),
@@ -478,7 +476,7 @@ auto idwt(WaveletTransform& wt, float* dwtop) -> void
             iter += detLen;
             detLen = wt.length[i + 2];
         }
-    } else if ((wt.extension() == SignalExtension::periodic) && (wt.convMethod() == ConvolutionMethod::direct)) {
+    } else if ((wt.extension() == SignalExtension::periodic) && (method == ConvolutionMethod::direct)) {
         appLen = wt.length[0];
         detLen = wt.length[1];
         n      = 2 * wt.length[j];
@@ -498,7 +496,7 @@ auto idwt(WaveletTransform& wt, float* dwtop) -> void
             iter += detLen;
             detLen = wt.length[i + 2];
         }
-    } else if ((wt.extension() == SignalExtension::symmetric) && (wt.convMethod() == ConvolutionMethod::direct)) {
+    } else if ((wt.extension() == SignalExtension::symmetric) && (method == ConvolutionMethod::direct)) {
         appLen = wt.length[0];
         detLen = wt.length[1];
         n      = 2 * wt.length[j] - 1;
@@ -516,7 +514,7 @@ auto idwt(WaveletTransform& wt, float* dwtop) -> void
             iter += detLen;
             detLen = wt.length[i + 2];
         }
-    } else if ((wt.extension() == SignalExtension::symmetric) && (wt.convMethod() == ConvolutionMethod::fft)) {
+    } else if ((wt.extension() == SignalExtension::symmetric) && (method == ConvolutionMethod::fft)) {
         lf = wt.wave().lpd().size();  // lpd and hpd have the same length
 
         n         = 2 * wt.length[j] - 1;
@@ -537,20 +535,15 @@ auto idwt(WaveletTransform& wt, float* dwtop) -> void
                 raise<InvalidArgument>("Decomposition Filters must have the same length");
             }
 
-            wt.convolver = makeUnique<FFTConvolver>(n2, lf);
-            wt.cfftset   = 1;
-
-            wconv(wt, {cAUp.get(), n2}, {wt.wave().lpr().data(), lf}, xLp.get());
+            wconv(wt, method, {cAUp.get(), n2}, {wt.wave().lpr().data(), lf}, xLp.get());
             upSample<float>(wt.output().data() + iter, detLen, u, cAUp.get());
-            wconv(wt, {cAUp.get(), n2}, {wt.wave().hpr().data(), lf}, xHp.get());
+            wconv(wt, method, {cAUp.get(), n2}, {wt.wave().hpr().data(), lf}, xHp.get());
 
             for (k = lf - 2; k < n2 + 1; ++k) { out[k - lf + 2] = xLp[k] + xHp[k]; }
             iter += detLen;
 
-            MC_ASSERT(wt.convMethod() == ConvolutionMethod::fft);
+            MC_ASSERT(method == ConvolutionMethod::fft);
             MC_ASSERT(wt.wave().lpr().size() == wt.wave().hpr().size());
-
-            wt.cfftset = 0;
         }
     } else {
         raise<InvalidArgument>("Signal extension can be either per or sym");
@@ -626,23 +619,13 @@ static auto swtFft(WaveletTransform& wt, float const* inp) -> void
 
         periodicExtension({wt.params.get(), tempLen}, n / 2, sig.get());
 
-        if (wt.wave().lpd().size() == wt.wave().hpd().size()
-            && (wt.convMethod() == ConvolutionMethod::fft)) {
-            wt.convolver = makeUnique<FFTConvolver>(n + tempLen + (tempLen % 2), n);
-            wt.cfftset   = 1;
-        } else if (!(wt.wave().lpd().size() == wt.wave().hpd().size())) {
+        if (wt.wave().lpd().size() != wt.wave().hpd().size()) {
             raise<InvalidArgument>("Decomposition Filters must have the same length");
         }
 
-        wconv(wt, {sig.get(), n + tempLen + (tempLen % 2)}, {lowPass.get(), n}, cA.get());
-
-        wconv(wt, {sig.get(), n + tempLen + (tempLen % 2)}, {highPass.get(), n}, cD.get());
-
-        if (wt.wave().lpd().size() == wt.wave().hpd().size()
-            && (wt.convMethod() == ConvolutionMethod::fft)) {
-
-            wt.cfftset = 0;
-        }
+        auto const extended = Span<float>{sig.get(), n + tempLen + (tempLen % 2)};
+        wconv(wt, ConvolutionMethod::fft, extended, {lowPass.get(), n}, cA.get());
+        wconv(wt, ConvolutionMethod::fft, extended, {highPass.get(), n}, cD.get());
 
         for (size_t i = 0; i < tempLen; ++i) {
             wt.params[i]          = cA[n + i];
@@ -689,10 +672,13 @@ static auto swtDirect(WaveletTransform& wt, float const* inp) -> void
 
 auto swt(WaveletTransform& wt, float const* inp) -> void
 {
-    if ((wt.method() == StringView{"swt"})
-        && (wt.convMethod() == ConvolutionMethod::direct)) {
+    // The upsampled filters of the deepest level dominate the cost
+    auto const deepest = wt.wave().lpd().size() << static_cast<size_t>(wt.levels() - 1);
+    auto const method  = convMethod(wt, wt.signalLength(), deepest);
+
+    if ((wt.method() == StringView{"swt"}) && (method == ConvolutionMethod::direct)) {
         swtDirect(wt, inp);
-    } else if ((wt.method() == StringView{"swt"}) && (wt.convMethod() == ConvolutionMethod::fft)) {
+    } else if ((wt.method() == StringView{"swt"}) && (method == ConvolutionMethod::fft)) {
         swtFft(wt, inp);
     } else {
         raise<InvalidArgument>("SWT Only accepts two methods - direct and fft");
@@ -706,6 +692,8 @@ auto iswt(WaveletTransform& wt, float* swtop) -> void
     auto u  = 2;
     auto lf = wt.wave().lpr().size();
 
+    auto const method = convMethod(wt, n, lf);
+
     auto appxSig = makeUnique<float[]>(n);
     auto detSig  = makeUnique<float[]>(n);
     auto appx1   = makeUnique<float[]>(n);
@@ -765,17 +753,13 @@ auto iswt(WaveletTransform& wt, float* swtop) -> void
 
             auto n1 = 2 * len0 + lf;
 
-            if (wt.wave().lpr().size() == wt.wave().hpr().size()
-                && (wt.convMethod() == ConvolutionMethod::fft)) {
-                wt.convolver = makeUnique<FFTConvolver>(n1, lf);
-                wt.cfftset   = 1;
-            } else if (!(wt.wave().lpd().size() == wt.wave().hpd().size())) {
+            if (wt.wave().lpd().size() != wt.wave().hpd().size()) {
                 raise<InvalidArgument>("Decomposition Filters must have the same length");
             }
 
-            wconv(wt, {cL0.get(), n1}, {wt.wave().lpr().data(), lf}, oup00L.get());
+            wconv(wt, method, {cL0.get(), n1}, {wt.wave().lpr().data(), lf}, oup00L.get());
 
-            wconv(wt, {cH0.get(), n1}, {wt.wave().hpr().data(), lf}, oup00H.get());
+            wconv(wt, method, {cH0.get(), n1}, {wt.wave().hpr().data(), lf}, oup00H.get());
 
             for (auto i = lf - 1; i < 2 * len0 + lf - 1; ++i) {
                 oup00[i - lf + 1] = oup00L[i] + oup00H[i];
@@ -807,8 +791,8 @@ auto iswt(WaveletTransform& wt, float* swtop) -> void
 
             n1 = 2 * len0 + lf;
 
-            wconv(wt, {cL0.get(), n1}, {wt.wave().lpr().data(), lf}, oup00L.get());
-            wconv(wt, {cH0.get(), n1}, {wt.wave().hpr().data(), lf}, oup00H.get());
+            wconv(wt, method, {cL0.get(), n1}, {wt.wave().lpr().data(), lf}, oup00L.get());
+            wconv(wt, method, {cH0.get(), n1}, {wt.wave().hpr().data(), lf}, oup00H.get());
 
             for (auto i = lf - 1; i < 2 * len0 + lf - 1; ++i) {
                 oup01[i - lf + 1] = oup00L[i] + oup00H[i];
@@ -895,37 +879,24 @@ static auto modwtDirect(WaveletTransform& wt, float const* inp) -> void
     }
 }
 
-static auto modwtFft(WaveletTransform& wt, float const* inp) -> void
+template<typename Engine>
+static auto modwtFft(WaveletTransform& wt, float const* inp, Engine& engine) -> void
 {
-    int j      = 0;
+    auto const n       = wt.modwtsiglength;
+    auto const j       = wt.levels();
+    auto const tempLen = wt.signalLength();
+    auto const lenAvg  = static_cast<size_t>(wt.wave().lpd().size());
+    auto const s       = sqrt(2.0F);
+
     int iter   = 0;
     int m      = 0;
     int lenacc = 0;
 
-    auto tempLen = wt.signalLength();
-    auto lenAvg  = static_cast<size_t>(wt.wave().lpd().size());
-    size_t n{0};
-    if (wt.extension() == SignalExtension::symmetric) {
-        n = 2 * tempLen;
-    } else if (wt.extension() == SignalExtension::periodic) {
-        n = tempLen;
-    }
-    j                 = wt.levels();
-    wt.modwtsiglength = n;
-    wt.length[0] = wt.length[j] = n;
-    wt.outlength = wt.length[j + 1] = (j + 1) * n;
-
-    auto const s = sqrt(2.0F);
-    for (iter = 1; iter < j; ++iter) { wt.length[iter] = n; }
-
-    auto fftFd = makeFFT(n);
-    auto fftBd = makeFFT(n);
-
-    auto sig      = Vector<Complex<float>>(n);
-    auto cA       = Vector<Complex<float>>(n);
-    auto cD       = Vector<Complex<float>>(n);
-    auto lowPass  = Vector<Complex<float>>(n);
-    auto highPass = Vector<Complex<float>>(n);
+    auto sig      = AlignedVector<Complex<float>>(n);
+    auto cA       = AlignedVector<Complex<float>>(n);
+    auto cD       = AlignedVector<Complex<float>>(n);
+    auto lowPass  = AlignedVector<Complex<float>>(n);
+    auto highPass = AlignedVector<Complex<float>>(n);
     auto index    = Vector<int>(n);
 
     // N-point FFT of low pass and high pass filters
@@ -941,7 +912,7 @@ static auto modwtFft(WaveletTransform& wt, float const* inp) -> void
         sig[i].imag(0.0F);
     }
 
-    fft(fftFd, sig, lowPass);
+    fft(engine, sig, lowPass);
 
     // High Pass Filter
 
@@ -954,7 +925,7 @@ static auto modwtFft(WaveletTransform& wt, float const* inp) -> void
         sig[i].imag(0.0F);
     }
 
-    fft(fftFd, sig, highPass);
+    fft(engine, sig, highPass);
 
     // symmetric extension
     for (size_t i = 0; i < tempLen; ++i) {
@@ -968,7 +939,7 @@ static auto modwtFft(WaveletTransform& wt, float const* inp) -> void
 
     // FFT of data
 
-    fft(fftFd, sig, cA);
+    fft(engine, sig, cA);
 
     lenacc = wt.outlength;
 
@@ -989,7 +960,7 @@ static auto modwtFft(WaveletTransform& wt, float const* inp) -> void
             cD[i].imag(highPass[index[i]].real() * tmp2 + highPass[index[i]].imag() * tmp1);
         }
 
-        ifft(fftBd, cD, sig);
+        ifft(engine, cD, sig);
 
         for (size_t i = 0; i < n; ++i) {
             wt.params[lenacc + i] = sig[i].real() / static_cast<float>(n);
@@ -998,14 +969,47 @@ static auto modwtFft(WaveletTransform& wt, float const* inp) -> void
         m *= 2;
     }
 
-    ifft(fftBd, cA, sig);
+    ifft(engine, cA, sig);
 
     for (size_t i = 0; i < n; ++i) { wt.params[i] = sig[i].real() / static_cast<float>(n); }
 }
 
+static auto modwtFft(WaveletTransform& wt, float const* inp) -> void
+{
+    int j    = 0;
+    int iter = 0;
+
+    auto tempLen = wt.signalLength();
+    size_t n{0};
+    if (wt.extension() == SignalExtension::symmetric) {
+        n = 2 * tempLen;
+    } else if (wt.extension() == SignalExtension::periodic) {
+        n = tempLen;
+    }
+    j                 = wt.levels();
+    wt.modwtsiglength = n;
+    wt.length[0] = wt.length[j] = n;
+    wt.outlength = wt.length[j + 1] = (j + 1) * n;
+
+    for (iter = 1; iter < j; ++iter) { wt.length[iter] = n; }
+
+    // Instantiated on the concrete engine, the transforms below run in a loop.
+    visitFFT(n, [&](auto& engine) { modwtFft(wt, inp, engine); });
+}
+
+// The direct MODWT only handles periodic extension
+static auto modwtMethod(WaveletTransform const& wt) -> ConvolutionMethod
+{
+    if (wt.extension() != SignalExtension::periodic
+        && wt.convMethod() == ConvolutionMethod::automatic) {
+        return ConvolutionMethod::fft;
+    }
+    return convMethod(wt, wt.signalLength(), wt.wave().lpd().size());
+}
+
 auto modwt(WaveletTransform& wt, float const* inp) -> void
 {
-    if (wt.convMethod() == ConvolutionMethod::direct) {
+    if (modwtMethod(wt) == ConvolutionMethod::direct) {
         modwtDirect(wt, inp);
         return;
     }
@@ -1018,21 +1022,19 @@ static auto conjComplex(Complex<float>* x, int n) -> void
     for (auto i = 0; i < n; ++i) { x[i].imag(x[i].imag() * -1.0F); }
 }
 
-auto imodwtFft(WaveletTransform& wt, float* oup) -> void
+template<typename Engine>
+static auto imodwtFft(WaveletTransform& wt, float* oup, Engine& engine) -> void
 {
     auto n      = wt.modwtsiglength;
     auto lenAvg = static_cast<size_t>(wt.wave().lpd().size());
     auto j      = static_cast<size_t>(wt.levels());
+    auto s      = sqrt(2.0F);
 
-    auto s     = sqrt(2.0F);
-    auto fftFd = makeFFT(n);
-    auto fftBd = makeFFT(n);
-
-    auto sig      = Vector<Complex<float>>(n);
-    auto cA       = Vector<Complex<float>>(n);
-    auto cD       = Vector<Complex<float>>(n);
-    auto lowPass  = Vector<Complex<float>>(n);
-    auto highPass = Vector<Complex<float>>(n);
+    auto sig      = AlignedVector<Complex<float>>(n);
+    auto cA       = AlignedVector<Complex<float>>(n);
+    auto cD       = AlignedVector<Complex<float>>(n);
+    auto lowPass  = AlignedVector<Complex<float>>(n);
+    auto highPass = AlignedVector<Complex<float>>(n);
     auto index    = makeUnique<size_t[]>(n);
 
     // N-point FFT of low pass and high pass filters
@@ -1048,7 +1050,7 @@ auto imodwtFft(WaveletTransform& wt, float* oup) -> void
         sig[i].imag(0.0F);
     }
 
-    fft(fftFd, sig, lowPass);
+    fft(engine, sig, lowPass);
 
     // High Pass Filter
 
@@ -1061,7 +1063,7 @@ auto imodwtFft(WaveletTransform& wt, float* oup) -> void
         sig[i].imag(0.0F);
     }
 
-    fft(fftFd, sig, highPass);
+    fft(engine, sig, highPass);
 
     // Complex conjugate of the two filters
 
@@ -1078,12 +1080,12 @@ auto imodwtFft(WaveletTransform& wt, float* oup) -> void
     }
 
     for (size_t iter = 0; iter < j; ++iter) {
-        fft(fftFd, sig, cA);
+        fft(engine, sig, cA);
         for (size_t i = 0; i < n; ++i) {
             sig[i].real(wt.output()[lenacc + i]);
             sig[i].imag(0.0F);
         }
-        fft(fftFd, sig, cD);
+        fft(engine, sig, cD);
 
         for (size_t i = 0; i < n; ++i) { index[i] = (m * i) % n; }
 
@@ -1102,7 +1104,7 @@ auto imodwtFft(WaveletTransform& wt, float* oup) -> void
             );
         }
 
-        ifft(fftBd, cA, sig);
+        ifft(engine, cA, sig);
 
         for (size_t i = 0; i < n; ++i) {
             sig[i].real(sig[i].real() / static_cast<float>(n));
@@ -1117,6 +1119,11 @@ auto imodwtFft(WaveletTransform& wt, float* oup) -> void
     });
 }
 
+auto imodwtFft(WaveletTransform& wt, float* oup) -> void
+{
+    visitFFT(wt.modwtsiglength, [&](auto& engine) { imodwtFft(wt, oup, engine); });
+}
+
 static auto imodwtPer(
     WaveletTransform& wt,
     int m,
@@ -1179,7 +1186,7 @@ static auto imodwtDirect(WaveletTransform& wt, float* dwtop) -> void
 
 auto imodwt(WaveletTransform& wt, float* oup) -> void
 {
-    if (wt.convMethod() == ConvolutionMethod::direct) {
+    if (modwtMethod(wt) == ConvolutionMethod::direct) {
         imodwtDirect(wt, oup);
         return;
     }
@@ -7,15 +7,25 @@
 #include <mc/fft/convolution.hpp>
 
 #include <mc/wavelet/algorithm/signal_extension.hpp>
+#include <mc/wavelet/transform/common.hpp>
 #include <mc/wavelet/wavelet.hpp>
 
 #include <mc/core/format.hpp>
 #include <mc/core/memory.hpp>
 #include <mc/core/span.hpp>
 #include <mc/core/string.hpp>
+#include <mc/core/vector.hpp>
 
 namespace mc {
 
+/// Convolver of the FFT convolution path with the filters bound to it. Kept by the
+/// transform across levels & calls, so every filter is transformed once per signal size.
+struct WaveletConvolver
+{
+    UniquePtr<FFTConvolver> convolver;
+    Vector<Vector<float>> filters;  // Bound patches, in bind order
+};
+
 struct WaveletTransform
 {
     WaveletTransform(Wavelet& wave, char const* method, size_t siglength, size_t j);
@@ -46,14 +56,14 @@ private:
     float* _output;
 
 public:
-    UniquePtr<FFTConvolver> convolver;
+    Vector<WaveletConvolver> convolvers;
+    PolyphaseFilters polyphase;  // Analysis filters of the direct DWT path
     size_t modwtsiglength;  // Modified signal length for MODWT
     size_t outlength;       // Length of the output DWT vector
     size_t lenlength;       // Length of the Output Dimension Vector "length"
     size_t MaxIter;         // Maximum Iterations J <= MaxIter
 
     size_t N{};  //
-    size_t cfftset{0};
     size_t zpad{};
     size_t length[102]{};
     UniquePtr<float[]> params;
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSL-1.0
 
 #include <mc/fft/algorithm.hpp>
+#include <mc/fft/transform/simd.hpp>
 
 #include <mc/wavelet/algorithm.hpp>
 
@@ -20,7 +21,11 @@ using namespace mc;
     {                                                                                      \
         using namespace mc;                                                                \
         static constexpr auto const epsilon = 6e-6F;                                       \
-        auto method    = GENERATE(ConvolutionMethod::fft, ConvolutionMethod::direct);      \
+        auto method    = GENERATE(                                                         \
+            ConvolutionMethod::fft,                                                        \
+            ConvolutionMethod::direct,                                                     \
+            ConvolutionMethod::automatic                                                   \
+        );                                                                                 \
         auto extension = GENERATE(SignalExtension::periodic, SignalExtension::symmetric);  \
         auto levels    = GENERATE(as<size_t>{}, 1, 2, 3);                                  \
         auto const n   = 11'025;                                                           \
@@ -307,3 +312,38 @@ MODWT_IMODWT_ROUNDTRIP("sym19")   // NOLINT
 MODWT_IMODWT_ROUNDTRIP("sym20")   // NOLINT
 
 #undef MODWT_IMODWT_ROUNDTRIP
+
+TEST_CASE("wavelet: WaveletTransform(dwt) - direct matches fft", "[dsp][wavelet]")
+{
+    auto const name      = GENERATE("db1", "db4", "sym7", "coif3", "db20");
+    auto const extension = GENERATE(SignalExtension::periodic, SignalExtension::symmetric);
+    auto const n         = GENERATE(size_t{1'000}, size_t{1'001});
+    auto const inp       = generateRandomTestData(n);
+
+    auto wavelet = Wavelet{name};
+    auto direct  = WaveletTransform(wavelet, "dwt", n, 3);
+    auto fft     = WaveletTransform(wavelet, "dwt", n, 3);
+    direct.extension(extension);
+    fft.extension(extension);
+    direct.convMethod(ConvolutionMethod::direct);
+    fft.convMethod(ConvolutionMethod::fft);
+    dwt(direct, data(inp));
+    dwt(fft, data(inp));
+
+    REQUIRE(direct.outlength == fft.outlength);
+    REQUIRE_THAT(
+        rmsError(direct.output().data(), fft.output().data(), direct.outlength),
+        Catch::Matchers::WithinAbs(0.0F, 1e-5F)
+    );
+
+    auto scalar = WaveletTransform(wavelet, "dwt", n, 3);
+    scalar.extension(extension);
+    scalar.convMethod(ConvolutionMethod::direct);
+    forceSimdLevel(SimdLevel::scalar);
+    dwt(scalar, data(inp));
+    resetSimdLevel();
+    REQUIRE_THAT(
+        rmsError(scalar.output().data(), direct.output().data(), direct.outlength),
+        Catch::Matchers::WithinAbs(0.0F, 1e-5F)
+    );
+}
@@ -4,6 +4,7 @@
 
 #include <mc/fft/algorithm.hpp>
 #include <mc/fft/convolution.hpp>
+#include <mc/fft/transform.hpp>
 
 #include <mc/wavelet/algorithm.hpp>
 
@@ -89,7 +90,7 @@ auto TempoDetect::operator()(Span<float const> input, float sampleRate) -> float
     // v - m; });
 
     auto s = FloatSignal(cDSum.data(), cDSum.size());
-    auto x = OverlapSaveConvolver(s, s);
+    auto x = OverlapSaveConvolver(s, s, fftThreads());
     x.crossCorrelate();
     auto correl = x.extractResult();
 